@@ -22,6 +22,8 @@ class ascon_provider
 {
 public:
 	static const bool is_xof = type != ascon_type::hash;
+	static const size_t static_hash_size = type == ascon_type::hash ? 256 : 0;
+	static const size_t max_hash_size = static_hash_size;
 
 	ascon_provider()
 		: squeezing(false)
@@ -7,10 +7,14 @@ This code is written by kerukuro and released into public domain.
 
 #include "../../detail/functions.hpp"
 #include "../../detail/absorb_data.hpp"
+#include "../../detail/parallel_for.hpp"
 #include "../../detail/validate_hash_size.hpp"
 #include "constants/blake2_constants.hpp"
+#include "simd/blake2_simd.hpp"
+#include <algorithm>
 #include <array>
 #include <limits>
+#include <vector>
 
 namespace digestpp
 {
@@ -116,10 +120,12 @@ class blake2_provider
 {
 public:
 	static const bool is_xof = type == blake2_type::xof;
+	static const size_t static_hash_size = HS;
+	static const size_t max_hash_size = type == blake2_type::hash ? sizeof(T) * 64 : type == blake2_type::x_hash ? sizeof(T) * sizeof(T) * 256 - 16 : 0;
 
 	template<size_t hss=HS, typename std::enable_if<hss == 0>::type* = nullptr>
 	blake2_provider(size_t hashsize = N)
-		: hs(hashsize), squeezing(false)
+		: hs(hashsize), squeezing(false), threads(1), min_parallel(1024 * 1024)
 	{
 		static_assert(sizeof(T) == 8 || sizeof(T) == 4, "Invalid T size");
 
@@ -137,7 +143,7 @@ public:
 
 	template<size_t hss=HS, typename std::enable_if<hss != 0>::type* = nullptr>
 	blake2_provider()
-		: hs(hss), squeezing(false)
+		: hs(hss), squeezing(false), threads(1), min_parallel(1024 * 1024)
 	{
 		static_assert(sizeof(T) == 8 || sizeof(T) == 4, "Invalid T size");
 
@@ -227,6 +233,12 @@ public:
 		memcpy(&p[0], personalization, personalization_len);
 	}
 
+	inline void set_threads(size_t thread_count, size_t min_size)
+	{
+		threads = thread_count;
+		min_parallel = min_size;
+	}
+
 	inline void set_blake2p_params(uint8_t fo, uint8_t nd, uint8_t no)
 	{
 		fanout = fo;
@@ -238,16 +250,7 @@ public:
 	{
 		size_t processed = 0;
 		if (!squeezing)
-		{
-			if (type == blake2_type::xof)
-				total += pos * 8;
-			squeezing = true;
-			xoffset = 0;
-			if (N / 4 != pos)
-				memset(&m[pos], 0, N / 4 - pos);
-			transform(m.data(), 1, true);
-			memcpy(&m[0], H.data(), N / 8);
-		}
+			finalize_root();
 		else if (pos < N / 8)
 		{
 			size_t to_copy = std::min(hs, N / 8 - pos);
@@ -255,28 +258,62 @@ public:
 			processed += to_copy;
 			pos += to_copy;
 		}
-		while (processed < hs)
+		size_t full = (hs - processed) / (N / 8);
+		if (full)
 		{
-			blake2_functions::initX(H, hs, processed, xoffset++, type == blake2_type::xof ? static_cast<T>(-1) : static_cast<T>(hs));
-			H[4] ^= s[0];
-			H[5] ^= s[1];
-			H[6] ^= p[0];
-			H[7] ^= p[1];
-			total = N;
-			memset(&m[N / 8], 0, m.size() - N / 8);
-			transform(m.data(), 1, true);
-			pos = std::min(hs - processed, N / 8);
+			output_parallel(xoffset, full, hash + processed);
+			xoffset += full;
+			processed += full * (N / 8);
+		}
+		if (processed < hs)
+		{
+			output_block(xoffset++, H);
+			pos = hs - processed;
 			memcpy(hash + processed, H.data(), pos);
-			processed += pos;
 		}
 	}
 
+	// Write len bytes of BLAKE2X output starting at offset, without changing the state
+	inline void squeeze_at(uint64_t offset, unsigned char* hash, size_t len) const
+	{
+		if (!squeezing)
+		{
+			blake2_provider copy(*this);
+			copy.finalize_root();
+			return copy.squeeze_at(offset, hash, len);
+		}
+		if (type == blake2_type::x_hash && (offset > hs / 8 || len > hs / 8 - offset))
+			throw std::runtime_error("invalid output range");
+
+		const size_t B = N / 8;
+		std::array<T, 8> block;
+		uint64_t index = offset / B;
+		size_t skip = static_cast<size_t>(offset % B);
+		if (skip && len)
+		{
+			size_t to_copy = std::min(len, B - skip);
+			output_block(index++, block);
+			memcpy(hash, reinterpret_cast<unsigned char*>(block.data()) + skip, to_copy);
+			hash += to_copy;
+			len -= to_copy;
+		}
+		output_parallel(index, len / B, hash);
+		index += len / B;
+		hash += len / B * B;
+		if (len % B)
+		{
+			output_block(index, block);
+			memcpy(hash, block.data(), len % B);
+		}
+		zero_memory(block);
+	}
+
 	inline void final(unsigned char* hash, size_t hs_override = 0)
 	{
-		total += pos * 8;
 		size_t hss = hs_override ? hs_override : hs;
 		if (type == blake2_type::hash)
 		{
+			total += pos * 8;
 			if (N / 4 != pos)
 				memset(&m[pos], 0, N / 4 - pos);
 			transform(m.data(), 1, true);
@@ -314,23 +351,107 @@ private:
 		update(key, sizeof(key));
 	}
 
+	// Compress the last block and keep the root hash in m, from which all output blocks of BLAKE2X are computed
+	inline void finalize_root()
+	{
+		total += pos * 8;
+		squeezing = true;
+		xoffset = 0;
+		if (N / 4 != pos)
+			memset(&m[pos], 0, N / 4 - pos);
+		transform(m.data(), 1, true);
+		memcpy(&m[0], H.data(), N / 8);
+		memset(&m[N / 8], 0, N / 8);
+		pos = N / 8;
+	}
+
+	// Initial state of BLAKE2X output block with the given index
+	inline void output_state(uint64_t index, std::array<T, 8>& state) const
+	{
+		T rhs = type == blake2_type::xof ? static_cast<T>(-1) : static_cast<T>(hs / 8);
+		blake2_functions::initX(state, hs / 8, static_cast<size_t>(index * (N / 8)), static_cast<size_t>(index), rhs);
+		state[4] ^= s[0];
+		state[5] ^= s[1];
+		state[6] ^= p[0];
+		state[7] ^= p[1];
+	}
+
+	inline void output_block(uint64_t index, std::array<T, 8>& state) const
+	{
+		output_state(index, state);
+		compress(state, m.data(), 1, N / 8, static_cast<T>(-1), last_node_flag());
+	}
+
+	// Compute count full output blocks starting at the given index, several blocks at once if SIMD lanes are available
+	inline void output_blocks(uint64_t index, size_t count, unsigned char* hash) const
+	{
+		const size_t B = N / 8;
+		const size_t L = blake2_simd::lanes<T>();
+		std::array<T, 8> state;
+		size_t i = 0;
+		if (L > 1)
+		{
+			T lanes[8 * 8];
+			const unsigned char* blocks[8];
+			for (; i + L <= count; i += L)
+			{
+				for (size_t l = 0; l < L; l++)
+				{
+					output_state(index + i + l, state);
+					for (size_t w = 0; w < 8; w++)
+						lanes[w * L + l] = state[w];
+					blocks[l] = m.data();
+				}
+				blake2_simd::transform_lanes<T>(lanes, blocks, 0, 1, N / 8, static_cast<T>(-1), last_node_flag());
+				for (size_t l = 0; l < L; l++)
+					for (size_t w = 0; w < 8; w++)
+						memcpy(hash + (i + l) * B + w * sizeof(T), &lanes[w * L + l], sizeof(T));
+			}
+			zero_memory(lanes, sizeof(lanes));
+		}
+		for (; i < count; i++)
+		{
+			output_block(index + i, state);
+			memcpy(hash + i * B, state.data(), B);
+		}
+		zero_memory(state);
+	}
+
+	// Compute output blocks; large outputs are split between threads
+	inline void output_parallel(uint64_t index, size_t count, unsigned char* hash) const
+	{
+		const size_t B = N / 8;
+		parallel_for(count, blake2_simd::lanes<T>(), count * B < min_parallel ? 1 : threads, [this, index, hash](size_t begin, size_t end) {
+			output_blocks(index + begin, end - begin, hash + begin * B);
+		});
+	}
+
+	inline T last_node_flag() const
+	{
+		return fanout && (nodeoffset == fanout - 1 || nodedepth) ? static_cast<T>(-1) : 0;
+	}
+
 	inline void transform(const unsigned char* data, size_t num_blks, bool padding)
 	{
+		T f0 = padding ? static_cast<T>(-1) : 0;
+		T f1 = padding ? last_node_flag() : 0;
+		compress(H, data, num_blks, total / 8 + (padding ? 0 : N / 4), f0, f1);
+	}
+
+	// Compress blocks; t is the byte counter after the first block, f0 and f1 are the finalization flags
+	static inline void compress(std::array<T, 8>& H, const unsigned char* data, size_t num_blks, uint64_t t, T f0, T f1)
+	{
+		if (blake2_simd::transform(H.data(), data, num_blks, t, f0, f1))
+			return;
+
 		for (size_t blk = 0; blk < num_blks; blk++)
 		{
 			T M[16];
 			for (int i = 0; i < 16; i++)
 				M[i] = reinterpret_cast<const T*>(data)[blk * 16 + i];
-			uint64_t totalbytes = total / 8 + (padding ? 0 : (blk + 1) * N) / 4;
+			uint64_t totalbytes = t + blk * (N / 4);
 			T t0 = static_cast<T>(totalbytes);
 			T t1 = N == 512 ? 0 : static_cast<T>(totalbytes >> 32);
-			T f0 = 0;
-			T f1 = 0;
-			if (padding)
-			{
-				f0 = static_cast<T>(-1);
-				f1 = fanout && (nodeoffset == fanout - 1 || nodedepth) ? static_cast<T>(-1) : 0;
-			}
 
 			T v[16];
 			memcpy(v, H.data(), sizeof(T) * 8);
@@ -384,11 +505,20 @@ private:
 	size_t hs;
 	size_t xoffset;
 	bool squeezing;
+	size_t threads;
+	size_t min_parallel;
 	uint8_t fanout;
 	uint8_t nodedepth;
 	uint8_t nodeoffset;
 };
 
+// BLAKE2X output can be computed at any offset
+template<typename P>
+struct is_blake2x : std::false_type {};
+
+template<typename T, blake2_type type, size_t HS>
+struct is_blake2x<blake2_provider<T, type, HS>> : std::integral_constant<bool, type != blake2_type::hash> {};
+
 } // namespace detail
 
 } // namespace digestpp
@@ -9,6 +9,7 @@ This code is written by kerukuro and released into public domain.
 #include "../../detail/absorb_data.hpp"
 #include "../../detail/validate_hash_size.hpp"
 #include "blake2_provider.hpp"
+#include "simd/blake2_simd.hpp"
 #include <array>
 #include <limits>
 
@@ -23,6 +24,8 @@ class blake2p_provider
 {
 public:
 	static const bool is_xof = type == blake2_type::xof;
+	static const size_t static_hash_size = HS;
+	static const size_t max_hash_size = type == blake2_type::hash ? sizeof(T) * 64 : type == blake2_type::x_hash ? sizeof(T) * sizeof(T) * 256 - 16 : 0;
 
 	template<size_t hss=HS, typename std::enable_if<hss == 0>::type* = nullptr>
 	blake2p_provider(size_t hashsize = N)
@@ -162,10 +165,10 @@ private:
 
 	inline void transform(const unsigned char* data, size_t num_blks)
 	{
-#ifdef _OPENMP
-#pragma omp parallel for
-#endif
-		for (int i = 0; i < static_cast<int>(P); i++)
+		if (blake2_simd::lanes<T>() == P)
+			return transform_leaves(data, num_blks);
+
+		for (size_t i = 0; i < P; i++)
 		{
 			for (size_t blk = 0; blk < num_blks; blk++)
 			{
@@ -174,6 +177,43 @@ private:
 		}
 	}
 
+	// Compress all leaves at once, one leaf per SIMD lane.
+	// All leaves receive the same amount of data, so they either all have a buffered block or none has;
+	// the last block of each leaf stays buffered, as it may need to be compressed with the finalization flag.
+	inline void transform_leaves(const unsigned char* data, size_t num_blks)
+	{
+		const size_t bs = sizeof(T) * 16;
+		T H[8 * P];
+		const unsigned char* blocks[P];
+		for (size_t p = 0; p < P; p++)
+			for (size_t w = 0; w < 8; w++)
+				H[w * P + p] = leaf[p].H[w];
+
+		uint64_t t = leaf[0].total / 8;
+		size_t compressed = 0;
+		if (leaf[0].pos)
+		{
+			for (size_t p = 0; p < P; p++)
+				blocks[p] = leaf[p].m.data();
+			blake2_simd::transform_lanes<T>(H, blocks, 0, 1, t + bs, 0, 0);
+			compressed++;
+		}
+		for (size_t p = 0; p < P; p++)
+			blocks[p] = data + p * bs;
+		blake2_simd::transform_lanes<T>(H, blocks, 512, num_blks - 1, t + (compressed + 1) * bs, 0, 0);
+		compressed += num_blks - 1;
+
+		for (size_t p = 0; p < P; p++)
+		{
+			for (size_t w = 0; w < 8; w++)
+				leaf[p].H[w] = H[w * P + p];
+			memcpy(leaf[p].m.data(), data + (num_blks - 1) * 512 + p * bs, bs);
+			leaf[p].pos = bs;
+			leaf[p].total += compressed * bs * 8;
+		}
+		zero_memory(H, sizeof(H));
+	}
+
 	constexpr static size_t N = sizeof(T) == 8 ? 512 : 256;
 	constexpr static size_t P = sizeof(T) == 8 ? 4 : 8;
 	blake2_provider<T, type, HS> main;
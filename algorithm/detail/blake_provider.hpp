@@ -149,6 +149,8 @@ class blake_provider
 {
 public:
 	static const bool is_xof = false;
+	static const size_t static_hash_size = HS;
+	static const size_t max_hash_size = 512;
 
 	template<size_t hss=HS, typename std::enable_if<hss == 0>::type* = nullptr>
 	blake_provider(size_t hashsize)
@@ -9,6 +9,7 @@ This code is written by kerukuro and released into public domain.
 #include "../../detail/absorb_data.hpp"
 #include "../../detail/validate_hash_size.hpp"
 #include "constants/echo_constants.hpp"
+#include "simd/echo_simd.hpp"
 #include <array>
 
 namespace digestpp
@@ -158,6 +159,8 @@ class echo_provider
 {
 public:
 	static const bool is_xof = false;
+	static const size_t static_hash_size = HS;
+	static const size_t max_hash_size = 512;
 
 	template<size_t hss=HS, typename std::enable_if<hss == 0>::type* = nullptr>
 	echo_provider(size_t hashsize)
@@ -249,8 +252,6 @@ private:
 		unsigned char* m = reinterpret_cast<unsigned char*>(h.data()) + 256 - block_bytes();
 		for (size_t blk = 0; blk < num_blks; blk++)
 		{
-			uint64_t w[32];
-
 			uint64_t counter = 0;
 			if (addedbits)
 			{
@@ -261,6 +262,10 @@ private:
 				if (m != mp)
 					memcpy(m, mp + block_bytes() * blk, delta);
 			}
+			if (echo_simd::transform(h.data(), salt.data(), counter, hs > 256))
+				continue;
+
+			uint64_t w[32];
 			memcpy(w, h.data(), sizeof(w));
 			int rounds = hs > 256 ? 10 : 8;
 			for (int l = 0; l < rounds; l++)
@@ -78,6 +78,8 @@ class esch_provider
 {
 public:
 	static const bool is_xof = XOF;
+	static const size_t static_hash_size = HS;
+	static const size_t max_hash_size = XOF ? 0 : N - 128;
 
 	template<bool xof=XOF, size_t hss = HS, typename std::enable_if<!xof && hss == 0>::type* = nullptr>
 	esch_provider(size_t hashsize)
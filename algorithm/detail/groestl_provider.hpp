@@ -9,6 +9,7 @@ This code is written by kerukuro and released into public domain.
 #include "../../detail/absorb_data.hpp"
 #include "../../detail/validate_hash_size.hpp"
 #include "constants/groestl_constants.hpp"
+#include "simd/groestl_simd.hpp"
 #include <array>
 
 namespace digestpp
@@ -105,6 +106,8 @@ class groestl_provider
 {
 public:
 	static const bool is_xof = false;
+	static const size_t static_hash_size = HS;
+	static const size_t max_hash_size = 512;
 
 	template<size_t hss=HS, typename std::enable_if<hss == 0>::type* = nullptr>
 	groestl_provider(size_t hashsize)
@@ -180,20 +183,33 @@ private:
 	inline void outputTransform()
 	{
 		if (hs > 256)
-			groestl_functions::outputTransform<16>(&h[0]);
+			outputTransform<16>();
 		else
-			groestl_functions::outputTransform<8>(&h[0]);
+			outputTransform<8>();
 	}
 
+	template<int R>
+	inline void outputTransform()
+	{
+		if (!groestl_simd::output_transform<R>(&h[0]))
+			groestl_functions::outputTransform<R>(&h[0]);
+	}
+
+	inline void transform(const unsigned char* mp, size_t num_blks)
+	{
+		if (hs > 256)
+			transform<16>(mp, num_blks);
+		else
+			transform<8>(mp, num_blks);
+	}
+
+	template<int R>
 	inline void transform(const unsigned char* mp, size_t num_blks)
 	{
+		if (groestl_simd::transform<R>(&h[0], mp, num_blks))
+			return;
 		for (size_t blk = 0; blk < num_blks; blk++)
-		{
-			if (hs > 256)
-				groestl_functions::transform<16>(&h[0], reinterpret_cast<const uint64_t*>(mp + block_bytes() * blk));
-			else
-				groestl_functions::transform<8>(&h[0], reinterpret_cast<const uint64_t*>(mp + block_bytes() * blk));
-		}
+			groestl_functions::transform<R>(&h[0], reinterpret_cast<const uint64_t*>(mp + R * 8 * blk));
 	}
 
 	std::array<uint64_t, 16> h;
@@ -9,6 +9,7 @@ This code is written by kerukuro and released into public domain.
 #include "../../detail/absorb_data.hpp"
 #include "../../detail/validate_hash_size.hpp"
 #include "constants/jh_constants.hpp"
+#include "simd/jh_simd.hpp"
 #include <array>
 
 namespace digestpp
@@ -100,6 +101,8 @@ class jh_provider
 {
 public:
 	static const bool is_xof = false;
+	static const size_t static_hash_size = HS;
+	static const size_t max_hash_size = 512;
 
 	template<size_t hss=HS, typename std::enable_if<hss == 0>::type* = nullptr>
 	jh_provider(size_t hashsize = 512)
@@ -169,6 +172,9 @@ public:
 private:
 	inline void transform(const unsigned char* mp, size_t num_blks)
 	{
+		if (jh_simd::transform(H.data(), mp, num_blks))
+			return;
+
 		for (uint64_t blk = 0; blk < num_blks; blk++)
 		{
 			const uint64_t* M = (const uint64_t*)(((const unsigned char*)mp) + blk * 64);
@@ -7,8 +7,12 @@ This code is written by kerukuro and released into public domain.
 
 #include "../../detail/functions.hpp"
 #include "../../detail/absorb_data.hpp"
+#include "../../detail/parallel_for.hpp"
 #include "shake_provider.hpp"
+#include "simd/sha3_simd.hpp"
+#include <algorithm>
 #include <array>
+#include <vector>
 
 namespace digestpp
 {
@@ -29,6 +33,7 @@ public:
 	static const bool is_xof = true;
 
 	k12m14_provider()
+		: threads(1), min_parallel(1024 * 1024)
 	{
 		static_assert(B == 128 || B == 256, "K12M14 only supports 128 and 256 bits");
 	}
@@ -43,6 +48,12 @@ public:
 		S = customization;
 	}
 
+	inline void set_threads(size_t max_threads, size_t min_size)
+	{
+		threads = max_threads ? max_threads : 1;
+		min_parallel = min_size;
+	}
+
 	inline void init()
 	{
 		main.init();
@@ -96,48 +107,69 @@ public:
 	{
 		(void)reallen;
 
-		for (uint64_t blk = 0; blk < num_blks; blk++)
+		if (!chunk && num_blks)
 		{
-			if (!chunk)
-			{
-				main.update(data, 8192);
-				main.update(reinterpret_cast<const unsigned char*>("\x03\x00\x00\x00\x00\x00\x00\x00"), 8);
-			}
-			else
-			{
-				child.update(data, 8192);
-				unsigned char buf[B / 4];
-				child.squeeze(buf, B / 4);
-				main.update(buf, B / 4);
-			}
-
-			child.init();
-			child.set_suffix(0x0b);
+			main.update(data, 8192);
+			main.update(reinterpret_cast<const unsigned char*>("\x03\x00\x00\x00\x00\x00\x00\x00"), 8);
 			++chunk;
 			data += 8192;
+			--num_blks;
 		}
+		if (num_blks)
+		{
+			// Leaves are independent, so their chaining values are computed first and then absorbed in order.
+			// Batches of 16 leaves per lane and thread keep the buffer size independent of the input.
+			size_t n = static_cast<size_t>(num_blks);
+			size_t use_threads = n * 8192 < min_parallel ? 1 : threads;
+			size_t batch = std::min(n, sha3_simd::lanes() * threads * 16);
+			leaf_cv.resize(batch * (B / 4));
+			while (n)
+			{
+				size_t leaves = std::min(n, batch);
+				hash_leaves(data, leaves, use_threads, leaf_cv.data());
+				main.update(leaf_cv.data(), leaves * (B / 4));
+				chunk += leaves;
+				data += leaves * 8192;
+				n -= leaves;
+			}
+		}
+		child.init();
+		child.set_suffix(0x0b);
 	}
 
-
 	inline void clear()
 	{
 		main.clear();
 		child.clear();
 		zero_memory(m);
+		zero_memory(leaf_cv.data(), leaf_cv.size());
 		zero_memory(S);
 		S.clear();
 	}
 
 private:
-	constexpr static size_t R = type == kangaroo_type::k12 ? 12 : 14;
+	// Hash n leaves with multi-lane Keccak, split between the given number of threads
+	inline void hash_leaves(const unsigned char* data, size_t n, size_t use_threads, unsigned char* cv)
+	{
+		const size_t rate = B == 128 ? 168 : 136;
+		size_t lanes = sha3_simd::lanes();
+		parallel_for(n, lanes, use_threads, [=](size_t begin, size_t end) {
+			sha3_simd::hash_chunks<R>(lanes, data + begin * 8192, end - begin, 8192, rate, 0x0b, cv + begin * (B / 4), B / 4);
+		});
+	}
+
+	constexpr static int R = type == kangaroo_type::k12 ? 12 : 14;
 	shake_provider<B, R> main;
 	shake_provider<B, R> child;
 	std::array<unsigned char, 8192> m;
+	std::vector<unsigned char> leaf_cv;
 	std::string S;
 	size_t pos;
 	size_t total;
 	size_t chunk;
 	bool squeezing;
+	size_t threads;
+	size_t min_parallel;
 };
 
 } // namespace detail
@@ -39,6 +39,7 @@ class kmac_provider
 {
 public:
 	static const bool is_xof = XOF;
+	static const size_t static_hash_size = HS;
 
 	template<bool xof=XOF, size_t hss=HS, typename std::enable_if<!xof && hss == 0>::type* = nullptr>
 	kmac_provider(size_t hashsize) : hs(hashsize)
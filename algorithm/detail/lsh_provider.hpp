@@ -9,6 +9,7 @@ This code is written by kerukuro and released into public domain.
 #include "../../detail/absorb_data.hpp"
 #include "../../detail/validate_hash_size.hpp"
 #include "constants/lsh_constants.hpp"
+#include "simd/lsh_simd.hpp"
 #include <array>
 
 namespace digestpp
@@ -71,6 +72,8 @@ class lsh_provider
 {
 public:
 	static const bool is_xof = false;
+	static const size_t static_hash_size = HS;
+	static const size_t max_hash_size = sizeof(T) * 64;
 
 	template<size_t hss=HS, typename std::enable_if<hss == 0>::type* = nullptr>
 	lsh_provider(size_t hashsize)
@@ -206,6 +209,9 @@ private:
 
 	inline void transform(const unsigned char* mp, size_t num_blks)
 	{
+		if (lsh_simd::transform(cv.data(), mp, num_blks))
+			return;
+
 		for (size_t blk = 0; blk < num_blks; blk++)
 		{
 			msgexpand(mp + block_bytes() * blk);
@@ -48,6 +48,8 @@ class md5_provider
 {
 public:
 	static const bool is_xof = false;
+	static const size_t static_hash_size = 128;
+	static const size_t max_hash_size = 128;
 
 	md5_provider()
 	{
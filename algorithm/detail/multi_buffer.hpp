@@ -0,0 +1,189 @@
+/*
+This code is written by kerukuro and released into public domain.
+*/
+
+#ifndef DIGESTPP_PROVIDERS_MULTI_BUFFER_HPP
+#define DIGESTPP_PROVIDERS_MULTI_BUFFER_HPP
+
+#include "../../detail/cpu_features.hpp"
+#include "../../detail/functions.hpp"
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+namespace digestpp
+{
+
+namespace detail
+{
+
+namespace multi_buffer
+{
+	// Hash independent messages with a compression function that processes L lanes at once.
+	// This is used for Merkle-Damgard hashes with 64-byte blocks and 32-bit words (SHA-256, SHA-1, MD5, SM3).
+	//
+	// E describes the hash function:
+	//   E::words       - number of 32-bit state words
+	//   E::digest_size - digest size in bytes (taken from the beginning of the state)
+	//   E::big_endian  - byte order of the state words in the digest and of the length in the padding
+	//   E::iv()        - pointer to the initial state
+	// transform(state, blocks) compresses one 64-byte block per lane, where the state is stored
+	// as state[word * L + lane] and blocks is an array of L pointers.
+	//
+	// Each lane hashes one message; when a lane finishes, its digest is written and the next message is loaded.
+	template<size_t L, typename E, typename F>
+	inline void hash(const unsigned char* const* data, const size_t* len, size_t count, unsigned char* out, F transform)
+	{
+		struct lane
+		{
+			size_t msg;
+			size_t blocks; // blocks left in the current segment (message data, then padding)
+			bool tail;
+			unsigned char pad[128];
+		};
+
+		const size_t idle = static_cast<size_t>(-1);
+		static const unsigned char dummy[64] = {};
+		std::array<uint32_t, E::words * L> state;
+		const unsigned char* blocks[L];
+		lane lanes[L];
+		size_t next = 0, active = 0;
+
+		// Switch the lane to the final 1 or 2 blocks with the last bytes of the message, padding and length
+		auto start_tail = [&](size_t l)
+		{
+			lane& ln = lanes[l];
+			size_t size = len[ln.msg];
+			size_t rem = size % 64;
+			size_t n = rem + 9 > 64 ? 2 : 1;
+			memset(ln.pad, 0, sizeof(ln.pad));
+			if (rem)
+				memcpy(ln.pad, data[ln.msg] + size - rem, rem);
+			ln.pad[rem] = 0x80;
+			uint64_t bits = static_cast<uint64_t>(size) * 8;
+			for (int i = 0; i < 8; i++)
+				ln.pad[n * 64 - (E::big_endian ? 1 + i : 8 - i)] = static_cast<unsigned char>(bits >> (i * 8));
+			ln.tail = true;
+			ln.blocks = n;
+			blocks[l] = ln.pad;
+		};
+
+		auto start = [&](size_t l)
+		{
+			lane& ln = lanes[l];
+			if (next == count)
+			{
+				ln.msg = idle;
+				blocks[l] = dummy;
+				return;
+			}
+			ln.msg = next++;
+			active++;
+			const uint32_t* iv = E::iv();
+			for (size_t w = 0; w < E::words; w++)
+				state[w * L + l] = iv[w];
+			ln.tail = false;
+			ln.blocks = len[ln.msg] / 64;
+			blocks[l] = data[ln.msg];
+			if (!ln.blocks)
+				start_tail(l);
+		};
+
+		auto finish = [&](size_t l)
+		{
+			unsigned char* digest = out + lanes[l].msg * E::digest_size;
+			for (size_t i = 0; i < E::digest_size; i++)
+			{
+				uint32_t w = state[i / 4 * L + l];
+				int shift = E::big_endian ? 24 - static_cast<int>(i % 4) * 8 : static_cast<int>(i % 4) * 8;
+				digest[i] = static_cast<unsigned char>(w >> shift);
+			}
+			active--;
+		};
+
+		for (size_t l = 0; l < L; l++)
+			start(l);
+		while (active)
+		{
+			transform(state.data(), blocks);
+			for (size_t l = 0; l < L; l++)
+			{
+				lane& ln = lanes[l];
+				if (ln.msg == idle)
+					continue;
+				blocks[l] += 64;
+				if (--ln.blocks)
+					continue;
+				if (!ln.tail)
+					start_tail(l);
+				else
+				{
+					finish(l);
+					start(l);
+				}
+			}
+		}
+		zero_memory(state);
+		for (size_t l = 0; l < L; l++)
+			zero_memory(lanes[l].pad, sizeof(lanes[l].pad));
+	}
+
+#ifdef DIGESTPP_X86_SIMD
+	// Load 32 bytes at offset from 8 blocks and transpose them, so that w[i] holds word i of all blocks.
+	// Big-endian words are byte-swapped.
+	template<bool big_endian>
+	DIGESTPP_TARGET("avx2")
+	inline void load_words_avx2(const unsigned char* const* blocks, size_t offset, __m256i* w)
+	{
+		const __m256i bswap = _mm256_set_epi64x(0x0c0d0e0f08090a0bull, 0x0405060700010203ull,
+				0x0c0d0e0f08090a0bull, 0x0405060700010203ull);
+		__m256i t[8], u[8];
+		for (int i = 0; i < 8; i++)
+			t[i] = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(blocks[i] + offset));
+		for (int i = 0; i < 8; i += 2)
+		{
+			u[i] = _mm256_unpacklo_epi32(t[i], t[i + 1]);
+			u[i + 1] = _mm256_unpackhi_epi32(t[i], t[i + 1]);
+		}
+		for (int i = 0; i < 8; i += 4)
+		{
+			t[i] = _mm256_unpacklo_epi64(u[i], u[i + 2]);
+			t[i + 1] = _mm256_unpackhi_epi64(u[i], u[i + 2]);
+			t[i + 2] = _mm256_unpacklo_epi64(u[i + 1], u[i + 3]);
+			t[i + 3] = _mm256_unpackhi_epi64(u[i + 1], u[i + 3]);
+		}
+		for (int i = 0; i < 4; i++)
+		{
+			w[i] = _mm256_permute2x128_si256(t[i], t[i + 4], 0x20);
+			w[i + 4] = _mm256_permute2x128_si256(t[i], t[i + 4], 0x31);
+		}
+		if (big_endian)
+		{
+			for (int i = 0; i < 8; i++)
+				w[i] = _mm256_shuffle_epi8(w[i], bswap);
+		}
+	}
+
+	// Load the 64-byte blocks of 16 lanes, so that w[i] holds word i of all blocks
+	template<bool big_endian>
+	DIGESTPP_TARGET("avx512f,avx512bw,avx512vl")
+	inline void load_words_avx512(const unsigned char* const* blocks, __m512i* w)
+	{
+		for (int half = 0; half < 2; half++)
+		{
+			__m256i lo[8], hi[8];
+			load_words_avx2<big_endian>(blocks, half * 32, lo);
+			load_words_avx2<big_endian>(blocks + 8, half * 32, hi);
+			for (int i = 0; i < 8; i++)
+				w[half * 8 + i] = _mm512_inserti64x4(_mm512_castsi256_si512(lo[i]), hi[i], 1);
+		}
+	}
+#endif
+}
+
+} // namespace detail
+
+} // namespace digestpp
+
+#endif
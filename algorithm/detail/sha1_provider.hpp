@@ -8,6 +8,7 @@ This code is written by kerukuro and released into public domain.
 #include "../../detail/functions.hpp"
 #include "../../detail/absorb_data.hpp"
 #include "constants/sha1_constants.hpp"
+#include "simd/sha1_simd.hpp"
 #include <array>
 
 namespace digestpp
@@ -32,12 +33,35 @@ namespace sha1_functions
 	{
 		return (x & y) ^ (x & z) ^ (y & z);
 	}
+
+	template<uint32_t (*f)(uint32_t, uint32_t, uint32_t)>
+	static inline void round(uint32_t a, uint32_t& b, uint32_t c, uint32_t d, uint32_t& e, uint32_t K, uint32_t W)
+	{
+		e += rotate_left(a, 5) + f(b, c, d) + K + W;
+		b = rotate_left(b, 30);
+	}
+
+	// 20 rounds with the round function f; the words are renamed instead of moved
+	template<uint32_t (*f)(uint32_t, uint32_t, uint32_t)>
+	static inline void rounds(uint32_t& a, uint32_t& b, uint32_t& c, uint32_t& d, uint32_t& e, uint32_t K, const uint32_t* W)
+	{
+		for (int t = 0; t < 20; t += 5)
+		{
+			round<f>(a, b, c, d, e, K, W[t]);
+			round<f>(e, a, b, c, d, K, W[t + 1]);
+			round<f>(d, e, a, b, c, K, W[t + 2]);
+			round<f>(c, d, e, a, b, K, W[t + 3]);
+			round<f>(b, c, d, e, a, K, W[t + 4]);
+		}
+	}
 }
 
 class sha1_provider
 {
 public:
 	static const bool is_xof = false;
+	static const size_t static_hash_size = 160;
+	static const size_t max_hash_size = 160;
 
 	sha1_provider()
 	{
@@ -95,6 +119,9 @@ public:
 private:
 	inline void transform(const unsigned char* data, size_t num_blks)
 	{
+		if (sha1_simd::transform(H.data(), data, num_blks))
+			return;
+
 		for (uint64_t blk = 0; blk < num_blks; blk++)
 		{
 			uint32_t M[16];
@@ -113,34 +140,10 @@ private:
 			uint32_t d = H[3];
 			uint32_t e = H[4];
 
-			uint32_t K = sha1_constants<void>::K[0];
-			auto f = sha1_functions::Ch;
-			for (int t = 0; t <= 79; t++)
-			{
-				uint32_t T = rotate_left(a, 5) + f(b, c, d) + e + K + W[t];
-				e = d;
-				d = c;
-				c = rotate_left(b, 30);
-				b = a;
-				a = T;
-
-				if (t == 19)
-				{
-					f = sha1_functions::Parity;
-					K = sha1_constants<void>::K[1];
-				}
-				else if (t == 39)
-				{
-					f = sha1_functions::Maj;
-					K = sha1_constants<void>::K[2];
-				}
-				else if (t == 59)
-				{
-					f = sha1_functions::Parity;
-					K = sha1_constants<void>::K[3];
-				}
-
-			}
+			sha1_functions::rounds<sha1_functions::Ch>(a, b, c, d, e, sha1_constants<void>::K[0], W);
+			sha1_functions::rounds<sha1_functions::Parity>(a, b, c, d, e, sha1_constants<void>::K[1], W + 20);
+			sha1_functions::rounds<sha1_functions::Maj>(a, b, c, d, e, sha1_constants<void>::K[2], W + 40);
+			sha1_functions::rounds<sha1_functions::Parity>(a, b, c, d, e, sha1_constants<void>::K[3], W + 60);
 			H[0] += a;
 			H[1] += b;
 			H[2] += c;
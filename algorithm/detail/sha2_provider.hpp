@@ -9,6 +9,7 @@ This code is written by kerukuro and released into public domain.
 #include "../../detail/absorb_data.hpp"
 #include "../../detail/validate_hash_size.hpp"
 #include "constants/sha2_constants.hpp"
+#include "simd/sha2_simd.hpp"
 #include <array>
 
 namespace digestpp
@@ -94,6 +95,8 @@ class sha2_provider
 {
 public:
 	static const bool is_xof = false;
+	static const size_t static_hash_size = O;
+	static const size_t max_hash_size = sizeof(T) * 64;
 
 	template<typename t=T, size_t o=O, typename std::enable_if<o != 0>::type* = nullptr>
 	sha2_provider()
@@ -215,6 +218,12 @@ public:
 
 private:
 	inline void transform(const unsigned char* data, size_t num_blks)
+	{
+		if (!sha2_simd::transform(H.data(), data, num_blks))
+			transform_portable(data, num_blks);
+	}
+
+	inline void transform_portable(const unsigned char* data, size_t num_blks)
 	{
 		for (size_t blk = 0; blk < num_blks; blk++)
 		{
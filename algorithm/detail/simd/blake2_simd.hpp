@@ -0,0 +1,446 @@
+/*
+This code is written by kerukuro and released into public domain.
+*/
+
+#ifndef DIGESTPP_PROVIDERS_BLAKE2_SIMD_HPP
+#define DIGESTPP_PROVIDERS_BLAKE2_SIMD_HPP
+
+#include "../../../detail/cpu_features.hpp"
+#include "../constants/blake2_constants.hpp"
+#include <cstddef>
+#include <cstdint>
+
+namespace digestpp
+{
+
+namespace detail
+{
+
+namespace blake2_simd
+{
+
+	inline const uint64_t* iv(uint64_t) { return blake2b_constants<void>::IV; }
+	inline const uint32_t* iv(uint32_t) { return blake2s_constants<void>::IV; }
+
+#ifdef DIGESTPP_X86_SIMD
+	// Lane-parallel BLAKE2: each lane of a vector holds the same word of a different state,
+	// so 4 BLAKE2b or 8 BLAKE2s compressions are computed at once.
+
+	DIGESTPP_TARGET("avx2")
+	inline __m256i set1_avx2(uint64_t x) { return _mm256_set1_epi64x(static_cast<long long>(x)); }
+
+	DIGESTPP_TARGET("avx2")
+	inline __m256i set1_avx2(uint32_t x) { return _mm256_set1_epi32(static_cast<int>(x)); }
+
+	// BLAKE2b G function in 4 lanes; rotations by multiples of 8 are byte shuffles
+	DIGESTPP_TARGET("avx2")
+	inline void g_avx2(uint64_t, __m256i& a, __m256i& b, __m256i& c, __m256i& d, __m256i x, __m256i y)
+	{
+		const __m256i r16 = _mm256_setr_epi8(2, 3, 4, 5, 6, 7, 0, 1, 10, 11, 12, 13, 14, 15, 8, 9,
+				2, 3, 4, 5, 6, 7, 0, 1, 10, 11, 12, 13, 14, 15, 8, 9);
+		const __m256i r24 = _mm256_setr_epi8(3, 4, 5, 6, 7, 0, 1, 2, 11, 12, 13, 14, 15, 8, 9, 10,
+				3, 4, 5, 6, 7, 0, 1, 2, 11, 12, 13, 14, 15, 8, 9, 10);
+		a = _mm256_add_epi64(_mm256_add_epi64(a, b), x);
+		d = _mm256_shuffle_epi32(_mm256_xor_si256(d, a), 0xb1);
+		c = _mm256_add_epi64(c, d);
+		b = _mm256_shuffle_epi8(_mm256_xor_si256(b, c), r24);
+		a = _mm256_add_epi64(_mm256_add_epi64(a, b), y);
+		d = _mm256_shuffle_epi8(_mm256_xor_si256(d, a), r16);
+		c = _mm256_add_epi64(c, d);
+		b = _mm256_xor_si256(b, c);
+		b = _mm256_xor_si256(_mm256_srli_epi64(b, 63), _mm256_add_epi64(b, b));
+	}
+
+	// BLAKE2s G function in 8 lanes
+	DIGESTPP_TARGET("avx2")
+	inline void g_avx2(uint32_t, __m256i& a, __m256i& b, __m256i& c, __m256i& d, __m256i x, __m256i y)
+	{
+		const __m256i r8 = _mm256_setr_epi8(1, 2, 3, 0, 5, 6, 7, 4, 9, 10, 11, 8, 13, 14, 15, 12,
+				1, 2, 3, 0, 5, 6, 7, 4, 9, 10, 11, 8, 13, 14, 15, 12);
+		const __m256i r16 = _mm256_setr_epi8(2, 3, 0, 1, 6, 7, 4, 5, 10, 11, 8, 9, 14, 15, 12, 13,
+				2, 3, 0, 1, 6, 7, 4, 5, 10, 11, 8, 9, 14, 15, 12, 13);
+		a = _mm256_add_epi32(_mm256_add_epi32(a, b), x);
+		d = _mm256_shuffle_epi8(_mm256_xor_si256(d, a), r16);
+		c = _mm256_add_epi32(c, d);
+		b = _mm256_xor_si256(b, c);
+		b = _mm256_or_si256(_mm256_srli_epi32(b, 12), _mm256_slli_epi32(b, 20));
+		a = _mm256_add_epi32(_mm256_add_epi32(a, b), y);
+		d = _mm256_shuffle_epi8(_mm256_xor_si256(d, a), r8);
+		c = _mm256_add_epi32(c, d);
+		b = _mm256_xor_si256(b, c);
+		b = _mm256_or_si256(_mm256_srli_epi32(b, 7), _mm256_slli_epi32(b, 25));
+	}
+
+	template<typename T>
+	DIGESTPP_TARGET("avx2")
+	inline void round_avx2(int r, const __m256i* M, __m256i* v)
+	{
+		const uint32_t* S = blake2_constants<void>::S[r];
+		g_avx2(T(), v[0], v[4], v[8], v[12], M[S[0]], M[S[1]]);
+		g_avx2(T(), v[1], v[5], v[9], v[13], M[S[2]], M[S[3]]);
+		g_avx2(T(), v[2], v[6], v[10], v[14], M[S[4]], M[S[5]]);
+		g_avx2(T(), v[3], v[7], v[11], v[15], M[S[6]], M[S[7]]);
+		g_avx2(T(), v[0], v[5], v[10], v[15], M[S[8]], M[S[9]]);
+		g_avx2(T(), v[1], v[6], v[11], v[12], M[S[10]], M[S[11]]);
+		g_avx2(T(), v[2], v[7], v[8], v[13], M[S[12]], M[S[13]]);
+		g_avx2(T(), v[3], v[4], v[9], v[14], M[S[14]], M[S[15]]);
+	}
+
+	// Load the message words of 4 blocks of BLAKE2b (4x4 transpose of 64-bit words)
+	DIGESTPP_TARGET("avx2")
+	inline void load_words_avx2(uint64_t, const unsigned char* const* blocks, size_t offset, __m256i* M)
+	{
+		for (int i = 0; i < 4; i++)
+		{
+			__m256i r[4];
+			for (int l = 0; l < 4; l++)
+				r[l] = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(blocks[l] + offset + i * 32));
+			__m256i t0 = _mm256_unpacklo_epi64(r[0], r[1]);
+			__m256i t1 = _mm256_unpackhi_epi64(r[0], r[1]);
+			__m256i t2 = _mm256_unpacklo_epi64(r[2], r[3]);
+			__m256i t3 = _mm256_unpackhi_epi64(r[2], r[3]);
+			M[i * 4 + 0] = _mm256_permute2x128_si256(t0, t2, 0x20);
+			M[i * 4 + 1] = _mm256_permute2x128_si256(t1, t3, 0x20);
+			M[i * 4 + 2] = _mm256_permute2x128_si256(t0, t2, 0x31);
+			M[i * 4 + 3] = _mm256_permute2x128_si256(t1, t3, 0x31);
+		}
+	}
+
+	// Load the message words of 8 blocks of BLAKE2s (two 8x8 transposes of 32-bit words)
+	DIGESTPP_TARGET("avx2")
+	inline void load_words_avx2(uint32_t, const unsigned char* const* blocks, size_t offset, __m256i* M)
+	{
+		for (int h = 0; h < 2; h++)
+		{
+			__m256i t[8], u[8];
+			for (int l = 0; l < 8; l++)
+				t[l] = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(blocks[l] + offset + h * 32));
+			for (int i = 0; i < 8; i += 2)
+			{
+				u[i] = _mm256_unpacklo_epi32(t[i], t[i + 1]);
+				u[i + 1] = _mm256_unpackhi_epi32(t[i], t[i + 1]);
+			}
+			for (int i = 0; i < 8; i += 4)
+			{
+				t[i] = _mm256_unpacklo_epi64(u[i], u[i + 2]);
+				t[i + 1] = _mm256_unpackhi_epi64(u[i], u[i + 2]);
+				t[i + 2] = _mm256_unpacklo_epi64(u[i + 1], u[i + 3]);
+				t[i + 3] = _mm256_unpackhi_epi64(u[i + 1], u[i + 3]);
+			}
+			for (int i = 0; i < 4; i++)
+			{
+				M[h * 8 + i] = _mm256_permute2x128_si256(t[i], t[i + 4], 0x20);
+				M[h * 8 + i + 4] = _mm256_permute2x128_si256(t[i], t[i + 4], 0x31);
+			}
+		}
+	}
+
+	// Compress num_blks blocks in each of 32 / sizeof(T) lanes.
+	// The state is stored as H[word * lanes + lane] and block b of lane l is read from blocks[l] + b * stride.
+	// The byte counter t (after the first block) and the finalization flags f0 and f1 are common to all lanes.
+	template<typename T>
+	DIGESTPP_TARGET("avx2")
+	inline void transform_lanes_avx2(T* H, const unsigned char* const* blocks, size_t stride, size_t num_blks, uint64_t t, T f0, T f1)
+	{
+		const size_t L = 32 / sizeof(T);
+		const int rounds = sizeof(T) == 8 ? 12 : 10;
+		const T* IV = iv(T());
+		__m256i h[8];
+		for (int i = 0; i < 8; i++)
+			h[i] = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(H + i * L));
+
+		for (size_t blk = 0; blk < num_blks; blk++, t += sizeof(T) * 16)
+		{
+			__m256i M[16], v[16];
+			load_words_avx2(T(), blocks, blk * stride, M);
+			for (int i = 0; i < 8; i++)
+				v[i] = h[i];
+			for (int i = 0; i < 4; i++)
+				v[i + 8] = set1_avx2(IV[i]);
+			v[12] = set1_avx2(static_cast<T>(IV[4] ^ static_cast<T>(t)));
+			v[13] = set1_avx2(static_cast<T>(sizeof(T) == 8 ? IV[5] : IV[5] ^ static_cast<T>(t >> 32)));
+			v[14] = set1_avx2(static_cast<T>(IV[6] ^ f0));
+			v[15] = set1_avx2(static_cast<T>(IV[7] ^ f1));
+			for (int r = 0; r < rounds; r++)
+				round_avx2<T>(r, M, v);
+			for (int i = 0; i < 8; i++)
+				h[i] = _mm256_xor_si256(h[i], _mm256_xor_si256(v[i], v[i + 8]));
+		}
+
+		for (int i = 0; i < 8; i++)
+			_mm256_storeu_si256(reinterpret_cast<__m256i*>(H + i * L), h[i]);
+	}
+
+	// Merge the message words selected from vector m into r
+	template<int s, int i0, int i1, int i2, int i3>
+	DIGESTPP_TARGET("avx2")
+	inline __m256i merge_words_avx2(__m256i m, __m256i r)
+	{
+		const int mask = (i0 / 4 == s ? 0x03 : 0) | (i1 / 4 == s ? 0x0c : 0) | (i2 / 4 == s ? 0x30 : 0) | (i3 / 4 == s ? 0xc0 : 0);
+		const int order = (i0 % 4) | (i1 % 4) << 2 | (i2 % 4) << 4 | (i3 % 4) << 6;
+		if (!mask)
+			return r;
+		__m256i w = order == 0xe4 ? m : _mm256_permute4x64_epi64(m, order);
+		return mask == 0xff ? w : _mm256_blend_epi32(r, w, mask);
+	}
+
+	// Select message words i0, i1, i2, i3 (of 16 words held in 4 vectors) into one vector
+	template<int i0, int i1, int i2, int i3>
+	DIGESTPP_TARGET("avx2")
+	inline __m256i select_words_avx2(const __m256i* m)
+	{
+		__m256i r = _mm256_setzero_si256();
+		r = merge_words_avx2<0, i0, i1, i2, i3>(m[0], r);
+		r = merge_words_avx2<1, i0, i1, i2, i3>(m[1], r);
+		r = merge_words_avx2<2, i0, i1, i2, i3>(m[2], r);
+		return merge_words_avx2<3, i0, i1, i2, i3>(m[3], r);
+	}
+
+	// One round of BLAKE2b on the rows of the state: the four G functions of the column step,
+	// then the rows are rotated so that the diagonals become columns, and rotated back afterwards
+	DIGESTPP_TARGET("avx2")
+	inline void round_rows_avx2(__m256i& a, __m256i& b, __m256i& c, __m256i& d, __m256i x0, __m256i y0, __m256i x1, __m256i y1)
+	{
+		g_avx2(uint64_t(), a, b, c, d, x0, y0);
+		b = _mm256_permute4x64_epi64(b, 0x39);
+		c = _mm256_permute4x64_epi64(c, 0x4e);
+		d = _mm256_permute4x64_epi64(d, 0x93);
+		g_avx2(uint64_t(), a, b, c, d, x1, y1);
+		b = _mm256_permute4x64_epi64(b, 0x93);
+		c = _mm256_permute4x64_epi64(c, 0x4e);
+		d = _mm256_permute4x64_epi64(d, 0x39);
+	}
+
+	// BLAKE2b compression with each row of the 4x4 state in one AVX2 register.
+	// t is the byte counter after the first block; f0 and f1 are the finalization flags.
+	DIGESTPP_TARGET("avx2")
+	inline void transform_avx2(uint64_t* H, const unsigned char* data, size_t num_blks, uint64_t t, uint64_t f0, uint64_t f1)
+	{
+		const uint64_t* IV = blake2b_constants<void>::IV;
+		__m256i h0 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(H));
+		__m256i h1 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(H + 4));
+		const __m256i iv0 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(IV));
+		const __m256i iv1 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(IV + 4));
+
+		for (size_t blk = 0; blk < num_blks; blk++, data += 128, t += 128)
+		{
+			__m256i m[4];
+			for (int i = 0; i < 4; i++)
+				m[i] = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i * 32));
+
+			__m256i a = h0, b = h1, c = iv0;
+			__m256i d = _mm256_xor_si256(iv1, _mm256_set_epi64x(static_cast<long long>(f1), static_cast<long long>(f0), 0, static_cast<long long>(t)));
+			round_rows_avx2(a, b, c, d, select_words_avx2<0, 2, 4, 6>(m), select_words_avx2<1, 3, 5, 7>(m),
+					select_words_avx2<8, 10, 12, 14>(m), select_words_avx2<9, 11, 13, 15>(m));
+			round_rows_avx2(a, b, c, d, select_words_avx2<14, 4, 9, 13>(m), select_words_avx2<10, 8, 15, 6>(m),
+					select_words_avx2<1, 0, 11, 5>(m), select_words_avx2<12, 2, 7, 3>(m));
+			round_rows_avx2(a, b, c, d, select_words_avx2<11, 12, 5, 15>(m), select_words_avx2<8, 0, 2, 13>(m),
+					select_words_avx2<10, 3, 7, 9>(m), select_words_avx2<14, 6, 1, 4>(m));
+			round_rows_avx2(a, b, c, d, select_words_avx2<7, 3, 13, 11>(m), select_words_avx2<9, 1, 12, 14>(m),
+					select_words_avx2<2, 5, 4, 15>(m), select_words_avx2<6, 10, 0, 8>(m));
+			round_rows_avx2(a, b, c, d, select_words_avx2<9, 5, 2, 10>(m), select_words_avx2<0, 7, 4, 15>(m),
+					select_words_avx2<14, 11, 6, 3>(m), select_words_avx2<1, 12, 8, 13>(m));
+			round_rows_avx2(a, b, c, d, select_words_avx2<2, 6, 0, 8>(m), select_words_avx2<12, 10, 11, 3>(m),
+					select_words_avx2<4, 7, 15, 1>(m), select_words_avx2<13, 5, 14, 9>(m));
+			round_rows_avx2(a, b, c, d, select_words_avx2<12, 1, 14, 4>(m), select_words_avx2<5, 15, 13, 10>(m),
+					select_words_avx2<0, 6, 9, 8>(m), select_words_avx2<7, 3, 2, 11>(m));
+			round_rows_avx2(a, b, c, d, select_words_avx2<13, 7, 12, 3>(m), select_words_avx2<11, 14, 1, 9>(m),
+					select_words_avx2<5, 15, 8, 2>(m), select_words_avx2<0, 4, 6, 10>(m));
+			round_rows_avx2(a, b, c, d, select_words_avx2<6, 14, 11, 0>(m), select_words_avx2<15, 9, 3, 8>(m),
+					select_words_avx2<12, 13, 1, 10>(m), select_words_avx2<2, 7, 4, 5>(m));
+			round_rows_avx2(a, b, c, d, select_words_avx2<10, 8, 7, 1>(m), select_words_avx2<2, 4, 6, 5>(m),
+					select_words_avx2<15, 9, 3, 13>(m), select_words_avx2<11, 14, 12, 0>(m));
+			round_rows_avx2(a, b, c, d, select_words_avx2<0, 2, 4, 6>(m), select_words_avx2<1, 3, 5, 7>(m),
+					select_words_avx2<8, 10, 12, 14>(m), select_words_avx2<9, 11, 13, 15>(m));
+			round_rows_avx2(a, b, c, d, select_words_avx2<14, 4, 9, 13>(m), select_words_avx2<10, 8, 15, 6>(m),
+					select_words_avx2<1, 0, 11, 5>(m), select_words_avx2<12, 2, 7, 3>(m));
+			h0 = _mm256_xor_si256(h0, _mm256_xor_si256(a, c));
+			h1 = _mm256_xor_si256(h1, _mm256_xor_si256(b, d));
+		}
+
+		_mm256_storeu_si256(reinterpret_cast<__m256i*>(H), h0);
+		_mm256_storeu_si256(reinterpret_cast<__m256i*>(H + 4), h1);
+	}
+
+	// BLAKE2s G function on the rows of the state
+	DIGESTPP_TARGET("sse4.1")
+	inline void g_sse41(__m128i& a, __m128i& b, __m128i& c, __m128i& d, __m128i x, __m128i y)
+	{
+		const __m128i r8 = _mm_setr_epi8(1, 2, 3, 0, 5, 6, 7, 4, 9, 10, 11, 8, 13, 14, 15, 12);
+		const __m128i r16 = _mm_setr_epi8(2, 3, 0, 1, 6, 7, 4, 5, 10, 11, 8, 9, 14, 15, 12, 13);
+		a = _mm_add_epi32(_mm_add_epi32(a, b), x);
+		d = _mm_shuffle_epi8(_mm_xor_si128(d, a), r16);
+		c = _mm_add_epi32(c, d);
+		b = _mm_xor_si128(b, c);
+		b = _mm_or_si128(_mm_srli_epi32(b, 12), _mm_slli_epi32(b, 20));
+		a = _mm_add_epi32(_mm_add_epi32(a, b), y);
+		d = _mm_shuffle_epi8(_mm_xor_si128(d, a), r8);
+		c = _mm_add_epi32(c, d);
+		b = _mm_xor_si128(b, c);
+		b = _mm_or_si128(_mm_srli_epi32(b, 7), _mm_slli_epi32(b, 25));
+	}
+
+	// Merge the message words selected from vector m into r
+	template<int s, int i0, int i1, int i2, int i3>
+	DIGESTPP_TARGET("sse4.1")
+	inline __m128i merge_words_sse41(__m128i m, __m128i r)
+	{
+		const int mask = (i0 / 4 == s ? 0x03 : 0) | (i1 / 4 == s ? 0x0c : 0) | (i2 / 4 == s ? 0x30 : 0) | (i3 / 4 == s ? 0xc0 : 0);
+		const int order = (i0 % 4) | (i1 % 4) << 2 | (i2 % 4) << 4 | (i3 % 4) << 6;
+		if (!mask)
+			return r;
+		__m128i w = order == 0xe4 ? m : _mm_shuffle_epi32(m, order);
+		return mask == 0xff ? w : _mm_blend_epi16(r, w, mask);
+	}
+
+	// Select message words i0, i1, i2, i3 (of 16 words held in 4 vectors) into one vector
+	template<int i0, int i1, int i2, int i3>
+	DIGESTPP_TARGET("sse4.1")
+	inline __m128i select_words_sse41(const __m128i* m)
+	{
+		__m128i r = _mm_setzero_si128();
+		r = merge_words_sse41<0, i0, i1, i2, i3>(m[0], r);
+		r = merge_words_sse41<1, i0, i1, i2, i3>(m[1], r);
+		r = merge_words_sse41<2, i0, i1, i2, i3>(m[2], r);
+		return merge_words_sse41<3, i0, i1, i2, i3>(m[3], r);
+	}
+
+	// One round of BLAKE2s on the rows of the state (see round_rows_avx2)
+	DIGESTPP_TARGET("sse4.1")
+	inline void round_rows_sse41(__m128i& a, __m128i& b, __m128i& c, __m128i& d, __m128i x0, __m128i y0, __m128i x1, __m128i y1)
+	{
+		g_sse41(a, b, c, d, x0, y0);
+		b = _mm_shuffle_epi32(b, 0x39);
+		c = _mm_shuffle_epi32(c, 0x4e);
+		d = _mm_shuffle_epi32(d, 0x93);
+		g_sse41(a, b, c, d, x1, y1);
+		b = _mm_shuffle_epi32(b, 0x93);
+		c = _mm_shuffle_epi32(c, 0x4e);
+		d = _mm_shuffle_epi32(d, 0x39);
+	}
+
+	// BLAKE2s compression with each row of the 4x4 state in one SSE register.
+	// t is the byte counter after the first block; f0 and f1 are the finalization flags.
+	DIGESTPP_TARGET("sse4.1")
+	inline void transform_sse41(uint32_t* H, const unsigned char* data, size_t num_blks, uint64_t t, uint32_t f0, uint32_t f1)
+	{
+		const uint32_t* IV = blake2s_constants<void>::IV;
+		__m128i h0 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(H));
+		__m128i h1 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(H + 4));
+		const __m128i iv0 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(IV));
+		const __m128i iv1 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(IV + 4));
+
+		for (size_t blk = 0; blk < num_blks; blk++, data += 64, t += 64)
+		{
+			__m128i m[4];
+			for (int i = 0; i < 4; i++)
+				m[i] = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i * 16));
+
+			__m128i a = h0, b = h1, c = iv0;
+			__m128i d = _mm_xor_si128(iv1, _mm_setr_epi32(static_cast<int>(t), static_cast<int>(t >> 32),
+					static_cast<int>(f0), static_cast<int>(f1)));
+			round_rows_sse41(a, b, c, d, select_words_sse41<0, 2, 4, 6>(m), select_words_sse41<1, 3, 5, 7>(m),
+					select_words_sse41<8, 10, 12, 14>(m), select_words_sse41<9, 11, 13, 15>(m));
+			round_rows_sse41(a, b, c, d, select_words_sse41<14, 4, 9, 13>(m), select_words_sse41<10, 8, 15, 6>(m),
+					select_words_sse41<1, 0, 11, 5>(m), select_words_sse41<12, 2, 7, 3>(m));
+			round_rows_sse41(a, b, c, d, select_words_sse41<11, 12, 5, 15>(m), select_words_sse41<8, 0, 2, 13>(m),
+					select_words_sse41<10, 3, 7, 9>(m), select_words_sse41<14, 6, 1, 4>(m));
+			round_rows_sse41(a, b, c, d, select_words_sse41<7, 3, 13, 11>(m), select_words_sse41<9, 1, 12, 14>(m),
+					select_words_sse41<2, 5, 4, 15>(m), select_words_sse41<6, 10, 0, 8>(m));
+			round_rows_sse41(a, b, c, d, select_words_sse41<9, 5, 2, 10>(m), select_words_sse41<0, 7, 4, 15>(m),
+					select_words_sse41<14, 11, 6, 3>(m), select_words_sse41<1, 12, 8, 13>(m));
+			round_rows_sse41(a, b, c, d, select_words_sse41<2, 6, 0, 8>(m), select_words_sse41<12, 10, 11, 3>(m),
+					select_words_sse41<4, 7, 15, 1>(m), select_words_sse41<13, 5, 14, 9>(m));
+			round_rows_sse41(a, b, c, d, select_words_sse41<12, 1, 14, 4>(m), select_words_sse41<5, 15, 13, 10>(m),
+					select_words_sse41<0, 6, 9, 8>(m), select_words_sse41<7, 3, 2, 11>(m));
+			round_rows_sse41(a, b, c, d, select_words_sse41<13, 7, 12, 3>(m), select_words_sse41<11, 14, 1, 9>(m),
+					select_words_sse41<5, 15, 8, 2>(m), select_words_sse41<0, 4, 6, 10>(m));
+			round_rows_sse41(a, b, c, d, select_words_sse41<6, 14, 11, 0>(m), select_words_sse41<15, 9, 3, 8>(m),
+					select_words_sse41<12, 13, 1, 10>(m), select_words_sse41<2, 7, 4, 5>(m));
+			round_rows_sse41(a, b, c, d, select_words_sse41<10, 8, 7, 1>(m), select_words_sse41<2, 4, 6, 5>(m),
+					select_words_sse41<15, 9, 3, 13>(m), select_words_sse41<11, 14, 12, 0>(m));
+			h0 = _mm_xor_si128(h0, _mm_xor_si128(a, c));
+			h1 = _mm_xor_si128(h1, _mm_xor_si128(b, d));
+		}
+
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(H), h0);
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(H + 4), h1);
+	}
+#endif
+
+	// Number of BLAKE2 states of type T that can be compressed at once
+	template<typename T>
+	inline size_t lanes()
+	{
+#ifdef DIGESTPP_X86_SIMD
+		if (cpu_features::get().avx2)
+			return 32 / sizeof(T);
+#endif
+		return 1;
+	}
+
+	// Compress blocks of lanes<T>() states at once; must only be called if lanes<T>() is greater than 1
+	template<typename T>
+	inline void transform_lanes(T* H, const unsigned char* const* blocks, size_t stride, size_t num_blks, uint64_t t, T f0, T f1)
+	{
+#ifdef DIGESTPP_X86_SIMD
+		transform_lanes_avx2(H, blocks, stride, num_blks, t, f0, f1);
+#else
+		(void)H;
+		(void)blocks;
+		(void)stride;
+		(void)num_blks;
+		(void)t;
+		(void)f0;
+		(void)f1;
+#endif
+	}
+
+	// Compress num_blks blocks of a single BLAKE2b or BLAKE2s state with a SIMD kernel.
+	// t is the byte counter after the first block, and is incremented by the block size for the following blocks.
+	// Returns false if no kernel is available for the CPU.
+	inline bool transform(uint64_t* H, const unsigned char* data, size_t num_blks, uint64_t t, uint64_t f0, uint64_t f1)
+	{
+#ifdef DIGESTPP_X86_SIMD
+		if (cpu_features::get().avx2)
+		{
+			transform_avx2(H, data, num_blks, t, f0, f1);
+			return true;
+		}
+#else
+		(void)H;
+		(void)data;
+		(void)num_blks;
+		(void)t;
+		(void)f0;
+		(void)f1;
+#endif
+		return false;
+	}
+
+	inline bool transform(uint32_t* H, const unsigned char* data, size_t num_blks, uint64_t t, uint32_t f0, uint32_t f1)
+	{
+#ifdef DIGESTPP_X86_SIMD
+		if (cpu_features::get().sse41)
+		{
+			transform_sse41(H, data, num_blks, t, f0, f1);
+			return true;
+		}
+#else
+		(void)H;
+		(void)data;
+		(void)num_blks;
+		(void)t;
+		(void)f0;
+		(void)f1;
+#endif
+		return false;
+	}
+
+} // namespace blake2_simd
+
+} // namespace detail
+
+} // namespace digestpp
+
+#endif // DIGESTPP_PROVIDERS_BLAKE2_SIMD_HPP
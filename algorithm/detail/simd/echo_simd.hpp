@@ -0,0 +1,180 @@
+/*
+This code is written by kerukuro and released into public domain.
+*/
+
+#ifndef DIGESTPP_PROVIDERS_ECHO_SIMD_HPP
+#define DIGESTPP_PROVIDERS_ECHO_SIMD_HPP
+
+#include "../../../detail/cpu_features.hpp"
+#include <cstddef>
+#include <cstdint>
+
+namespace digestpp
+{
+
+namespace detail
+{
+
+namespace echo_simd
+{
+#ifdef DIGESTPP_X86_SIMD
+	// ECHO state is a 4x4 matrix of 128-bit words (word 4 * column + row), and BigSubWords is two AES rounds
+	// per word, keyed with the counter and the salt, so it maps directly to AESENC.
+	// BigMixColumns is the AES MixColumns applied to the bytes at the same position of the 4 words in a column.
+
+	// Multiply each byte by 2 in GF(2^8)
+	DIGESTPP_TARGET("aes")
+	inline __m128i xtime(__m128i x)
+	{
+		__m128i hi = _mm_cmpgt_epi8(_mm_setzero_si128(), x);
+		return _mm_xor_si128(_mm_add_epi8(x, x), _mm_and_si128(hi, _mm_set1_epi8(0x1b)));
+	}
+
+	DIGESTPP_TARGET("aes")
+	inline void mix_column(__m128i a, __m128i b, __m128i c, __m128i d, __m128i* out)
+	{
+		__m128i s = _mm_xor_si128(_mm_xor_si128(a, b), _mm_xor_si128(c, d));
+		out[0] = _mm_xor_si128(_mm_xor_si128(s, a), xtime(_mm_xor_si128(a, b)));
+		out[1] = _mm_xor_si128(_mm_xor_si128(s, b), xtime(_mm_xor_si128(b, c)));
+		out[2] = _mm_xor_si128(_mm_xor_si128(s, c), xtime(_mm_xor_si128(c, d)));
+		out[3] = _mm_xor_si128(_mm_xor_si128(s, d), xtime(_mm_xor_si128(d, a)));
+	}
+
+	// One block with AES-NI; h holds the chaining value followed by the message block
+	DIGESTPP_TARGET("aes")
+	inline void transform_aes(uint64_t* h, const uint64_t* salt, uint64_t counter, bool wide)
+	{
+		__m128i w[16];
+		for (int i = 0; i < 16; i++)
+			w[i] = _mm_loadu_si128(reinterpret_cast<const __m128i*>(h + i * 2));
+		const __m128i k2 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(salt));
+		const __m128i one = _mm_set_epi64x(0, 1);
+		__m128i k1 = _mm_set_epi64x(0, static_cast<long long>(counter));
+
+		int rounds = wide ? 10 : 8;
+		for (int l = 0; l < rounds; l++)
+		{
+			for (int i = 0; i < 16; i++)
+			{
+				w[i] = _mm_aesenc_si128(_mm_aesenc_si128(w[i], k1), k2);
+				k1 = _mm_add_epi64(k1, one);
+			}
+			// BigShiftRows moves row r of the matrix by r columns
+			__m128i t[16];
+			for (int c = 0; c < 4; c++)
+				mix_column(w[c * 4], w[(c + 1) % 4 * 4 + 1], w[(c + 2) % 4 * 4 + 2], w[(c + 3) % 4 * 4 + 3], t + c * 4);
+			for (int i = 0; i < 16; i++)
+				w[i] = t[i];
+		}
+
+		// Columns 0-3 (or 0-1 for wide state) are folded into the first column (or columns)
+		int cv = wide ? 8 : 4;
+		for (int i = 0; i < cv; i++)
+		{
+			__m128i x = _mm_setzero_si128();
+			for (int j = i; j < 16; j += cv)
+				x = _mm_xor_si128(x, _mm_xor_si128(w[j], _mm_loadu_si128(reinterpret_cast<const __m128i*>(h + j * 2))));
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(h + i * 2), x);
+		}
+	}
+
+	// With VAES each vector holds one row of the matrix, so that BigSubWords and BigMixColumns process
+	// 4 words per instruction, and BigShiftRows rotates the words within each vector.
+	DIGESTPP_TARGET("vaes,avx512f,avx512bw,avx512vl")
+	inline __m512i xtime_avx512(__m512i x)
+	{
+		__m512i poly = _mm512_maskz_mov_epi8(_mm512_movepi8_mask(x), _mm512_set1_epi8(0x1b));
+		return _mm512_xor_si512(_mm512_add_epi8(x, x), poly);
+	}
+
+	// Transpose a 4x4 matrix of 128-bit words
+	DIGESTPP_TARGET("vaes,avx512f,avx512bw,avx512vl")
+	inline void transpose_avx512(__m512i* a)
+	{
+		__m512i t0 = _mm512_shuffle_i64x2(a[0], a[1], 0x44);
+		__m512i t1 = _mm512_shuffle_i64x2(a[0], a[1], 0xee);
+		__m512i t2 = _mm512_shuffle_i64x2(a[2], a[3], 0x44);
+		__m512i t3 = _mm512_shuffle_i64x2(a[2], a[3], 0xee);
+		a[0] = _mm512_shuffle_i64x2(t0, t2, 0x88);
+		a[1] = _mm512_shuffle_i64x2(t0, t2, 0xdd);
+		a[2] = _mm512_shuffle_i64x2(t1, t3, 0x88);
+		a[3] = _mm512_shuffle_i64x2(t1, t3, 0xdd);
+	}
+
+	DIGESTPP_TARGET("vaes,avx512f,avx512bw,avx512vl")
+	inline void transform_vaes(uint64_t* h, const uint64_t* salt, uint64_t counter, bool wide)
+	{
+		__m512i w[4], k1[4];
+		for (int i = 0; i < 4; i++)
+			w[i] = _mm512_loadu_si512(h + i * 8);
+		transpose_avx512(w);
+
+		// Word 4 * c + r is at lane c of row r
+		const __m512i k2 = _mm512_broadcast_i32x4(_mm_loadu_si128(reinterpret_cast<const __m128i*>(salt)));
+		const __m512i step = _mm512_maskz_set1_epi64(0x55, 16);
+		const __m512i ctr = _mm512_maskz_set1_epi64(0x55, static_cast<long long>(counter));
+		for (int r = 0; r < 4; r++)
+			k1[r] = _mm512_add_epi64(ctr, _mm512_set_epi64(0, 12 + r, 0, 8 + r, 0, 4 + r, 0, r));
+
+		int rounds = wide ? 10 : 8;
+		for (int l = 0; l < rounds; l++)
+		{
+			for (int r = 0; r < 4; r++)
+			{
+				w[r] = _mm512_aesenc_epi128(_mm512_aesenc_epi128(w[r], k1[r]), k2);
+				k1[r] = _mm512_add_epi64(k1[r], step);
+			}
+			__m512i a = w[0];
+			__m512i b = _mm512_shuffle_i64x2(w[1], w[1], 0x39);
+			__m512i c = _mm512_shuffle_i64x2(w[2], w[2], 0x4e);
+			__m512i d = _mm512_shuffle_i64x2(w[3], w[3], 0x93);
+			__m512i s = _mm512_xor_si512(_mm512_xor_si512(a, b), _mm512_xor_si512(c, d));
+			w[0] = _mm512_xor_si512(_mm512_xor_si512(s, a), xtime_avx512(_mm512_xor_si512(a, b)));
+			w[1] = _mm512_xor_si512(_mm512_xor_si512(s, b), xtime_avx512(_mm512_xor_si512(b, c)));
+			w[2] = _mm512_xor_si512(_mm512_xor_si512(s, c), xtime_avx512(_mm512_xor_si512(c, d)));
+			w[3] = _mm512_xor_si512(_mm512_xor_si512(s, d), xtime_avx512(_mm512_xor_si512(d, a)));
+		}
+
+		transpose_avx512(w);
+		for (int i = 0; i < 4; i++)
+			w[i] = _mm512_xor_si512(w[i], _mm512_loadu_si512(h + i * 8));
+		if (wide)
+		{
+			_mm512_storeu_si512(h, _mm512_xor_si512(w[0], w[2]));
+			_mm512_storeu_si512(h + 8, _mm512_xor_si512(w[1], w[3]));
+		}
+		else
+			_mm512_storeu_si512(h, _mm512_xor_si512(_mm512_xor_si512(w[0], w[1]), _mm512_xor_si512(w[2], w[3])));
+	}
+#endif
+
+	// Compress one block with the counter value for its first word.
+	// The state has 4 words of chaining value (8 words if wide is set) and the message block.
+	// Returns false if no kernel is available on this CPU.
+	inline bool transform(uint64_t* h, const uint64_t* salt, uint64_t counter, bool wide)
+	{
+#ifdef DIGESTPP_X86_SIMD
+		const cpu_features& cpu = cpu_features::get();
+		if (cpu.vaes)
+			transform_vaes(h, salt, counter, wide);
+		else if (cpu.aesni)
+			transform_aes(h, salt, counter, wide);
+		else
+			return false;
+		return true;
+#else
+		(void)h;
+		(void)salt;
+		(void)counter;
+		(void)wide;
+		return false;
+#endif
+	}
+
+} // namespace echo_simd
+
+} // namespace detail
+
+} // namespace digestpp
+
+#endif // DIGESTPP_PROVIDERS_ECHO_SIMD_HPP
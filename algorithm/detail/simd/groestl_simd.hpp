@@ -0,0 +1,351 @@
+/*
+This code is written by kerukuro and released into public domain.
+*/
+
+#ifndef DIGESTPP_PROVIDERS_GROESTL_SIMD_HPP
+#define DIGESTPP_PROVIDERS_GROESTL_SIMD_HPP
+
+#include "../../../detail/cpu_features.hpp"
+#include <cstddef>
+#include <cstdint>
+
+namespace digestpp
+{
+
+namespace detail
+{
+
+namespace groestl_simd
+{
+	// Groestl permutations with AES-NI. The state is transposed, so that each vector holds one row of the matrix;
+	// MixBytes then multiplies whole rows by constants, and ShiftBytes is a byte shuffle within each row.
+	// SubBytes is computed by AESENCLAST with a zero round key, which also applies the AES ShiftRows
+	// permutation; the shuffles below combine ShiftBytes with the inverse of ShiftRows.
+	//
+	// P512 and Q512 (Groestl-224/256): row i of P in the low half of vector i and row i of Q in the high half.
+	// P1024 and Q1024 (Groestl-384/512): one row per vector, P and Q rounds are interleaved.
+	template<typename T>
+	struct shuffles
+	{
+		const static unsigned char PQ512[8][16];
+		const static unsigned char P1024[8][16];
+		const static unsigned char Q1024[8][16];
+	};
+
+	template<typename T>
+	const unsigned char shuffles<T>::PQ512[8][16] = {
+		{ 0, 14, 11, 7, 4, 1, 15, 12, 9, 5, 2, 8, 13, 10, 6, 3 },
+		{ 1, 8, 13, 0, 5, 2, 9, 14, 11, 6, 3, 10, 15, 12, 7, 4 },
+		{ 2, 10, 15, 1, 6, 3, 11, 8, 13, 7, 4, 12, 9, 14, 0, 5 },
+		{ 3, 12, 9, 2, 7, 4, 13, 10, 15, 0, 5, 14, 11, 8, 1, 6 },
+		{ 4, 13, 10, 3, 0, 5, 14, 11, 8, 1, 6, 15, 12, 9, 2, 7 },
+		{ 5, 15, 12, 4, 1, 6, 8, 13, 10, 2, 7, 9, 14, 11, 3, 0 },
+		{ 6, 9, 14, 5, 2, 7, 10, 15, 12, 3, 0, 11, 8, 13, 4, 1 },
+		{ 7, 11, 8, 6, 3, 0, 12, 9, 14, 4, 1, 13, 10, 15, 5, 2 }
+	};
+
+	template<typename T>
+	const unsigned char shuffles<T>::P1024[8][16] = {
+		{ 0, 13, 10, 7, 4, 1, 14, 11, 8, 5, 2, 15, 12, 9, 6, 3 },
+		{ 1, 14, 11, 8, 5, 2, 15, 12, 9, 6, 3, 0, 13, 10, 7, 4 },
+		{ 2, 15, 12, 9, 6, 3, 0, 13, 10, 7, 4, 1, 14, 11, 8, 5 },
+		{ 3, 0, 13, 10, 7, 4, 1, 14, 11, 8, 5, 2, 15, 12, 9, 6 },
+		{ 4, 1, 14, 11, 8, 5, 2, 15, 12, 9, 6, 3, 0, 13, 10, 7 },
+		{ 5, 2, 15, 12, 9, 6, 3, 0, 13, 10, 7, 4, 1, 14, 11, 8 },
+		{ 6, 3, 0, 13, 10, 7, 4, 1, 14, 11, 8, 5, 2, 15, 12, 9 },
+		{ 11, 8, 5, 2, 15, 12, 9, 6, 3, 0, 13, 10, 7, 4, 1, 14 }
+	};
+
+	template<typename T>
+	const unsigned char shuffles<T>::Q1024[8][16] = {
+		{ 1, 14, 11, 8, 5, 2, 15, 12, 9, 6, 3, 0, 13, 10, 7, 4 },
+		{ 3, 0, 13, 10, 7, 4, 1, 14, 11, 8, 5, 2, 15, 12, 9, 6 },
+		{ 5, 2, 15, 12, 9, 6, 3, 0, 13, 10, 7, 4, 1, 14, 11, 8 },
+		{ 11, 8, 5, 2, 15, 12, 9, 6, 3, 0, 13, 10, 7, 4, 1, 14 },
+		{ 0, 13, 10, 7, 4, 1, 14, 11, 8, 5, 2, 15, 12, 9, 6, 3 },
+		{ 2, 15, 12, 9, 6, 3, 0, 13, 10, 7, 4, 1, 14, 11, 8, 5 },
+		{ 4, 1, 14, 11, 8, 5, 2, 15, 12, 9, 6, 3, 0, 13, 10, 7 },
+		{ 6, 3, 0, 13, 10, 7, 4, 1, 14, 11, 8, 5, 2, 15, 12, 9 }
+	};
+
+#ifdef DIGESTPP_X86_SIMD
+	// Multiply each byte by 2 in GF(2^8)
+	DIGESTPP_TARGET("ssse3")
+	inline __m128i xtime(__m128i x)
+	{
+		__m128i hi = _mm_cmpgt_epi8(_mm_setzero_si128(), x);
+		return _mm_xor_si128(_mm_add_epi8(x, x), _mm_and_si128(hi, _mm_set1_epi8(0x1b)));
+	}
+
+	// Row i of MixBytes: the sum of b[k] * a[i + k] with b = { 2, 2, 3, 4, 5, 3, 5, 7 },
+	// split by powers of 2 into the sums of rows multiplied by 1, 2 and 4; t[i] = a[i] ^ a[i + 1]
+	DIGESTPP_TARGET("ssse3")
+	inline __m128i mix_row(const __m128i* a, const __m128i* t, int i)
+	{
+		__m128i s4 = _mm_xor_si128(t[(i + 3) % 8], t[(i + 6) % 8]);
+		__m128i s1 = _mm_xor_si128(_mm_xor_si128(a[(i + 2) % 8], t[(i + 4) % 8]), t[(i + 6) % 8]);
+		__m128i s2 = _mm_xor_si128(_mm_xor_si128(t[i], a[(i + 2) % 8]), _mm_xor_si128(a[(i + 5) % 8], a[(i + 7) % 8]));
+		return _mm_xor_si128(s1, xtime(_mm_xor_si128(s2, xtime(s4))));
+	}
+
+	// MixBytes on 8 rows
+	DIGESTPP_TARGET("ssse3")
+	inline void mix_bytes(__m128i* a)
+	{
+		const __m128i t[8] = {
+			_mm_xor_si128(a[0], a[1]), _mm_xor_si128(a[1], a[2]), _mm_xor_si128(a[2], a[3]), _mm_xor_si128(a[3], a[4]),
+			_mm_xor_si128(a[4], a[5]), _mm_xor_si128(a[5], a[6]), _mm_xor_si128(a[6], a[7]), _mm_xor_si128(a[7], a[0])
+		};
+		const __m128i b[8] = {
+			mix_row(a, t, 0), mix_row(a, t, 1), mix_row(a, t, 2), mix_row(a, t, 3),
+			mix_row(a, t, 4), mix_row(a, t, 5), mix_row(a, t, 6), mix_row(a, t, 7)
+		};
+		for (int i = 0; i < 8; i++)
+			a[i] = b[i];
+	}
+
+	// SubBytes and ShiftBytes on 8 rows
+	DIGESTPP_TARGET("aes,ssse3")
+	inline void sub_shift_bytes(__m128i* a, const unsigned char (*shuffle)[16])
+	{
+		for (int i = 0; i < 8; i++)
+		{
+			__m128i s = _mm_loadu_si128(reinterpret_cast<const __m128i*>(shuffle[i]));
+			a[i] = _mm_aesenclast_si128(_mm_shuffle_epi8(a[i], s), _mm_setzero_si128());
+		}
+	}
+
+	// Transpose an 8x8 byte matrix stored as 4 vectors of 2 lines each
+	DIGESTPP_TARGET("ssse3")
+	inline void transpose(__m128i* a)
+	{
+		const __m128i pairs = _mm_setr_epi8(0, 8, 1, 9, 2, 10, 3, 11, 4, 12, 5, 13, 6, 14, 7, 15);
+		__m128i b0 = _mm_shuffle_epi8(a[0], pairs);
+		__m128i b1 = _mm_shuffle_epi8(a[1], pairs);
+		__m128i b2 = _mm_shuffle_epi8(a[2], pairs);
+		__m128i b3 = _mm_shuffle_epi8(a[3], pairs);
+		__m128i c0 = _mm_unpacklo_epi16(b0, b1);
+		__m128i c1 = _mm_unpackhi_epi16(b0, b1);
+		__m128i c2 = _mm_unpacklo_epi16(b2, b3);
+		__m128i c3 = _mm_unpackhi_epi16(b2, b3);
+		a[0] = _mm_unpacklo_epi32(c0, c2);
+		a[1] = _mm_unpackhi_epi32(c0, c2);
+		a[2] = _mm_unpacklo_epi32(c1, c3);
+		a[3] = _mm_unpackhi_epi32(c1, c3);
+	}
+
+	// Load 16 columns of 8 bytes as 8 rows of 16 bytes
+	DIGESTPP_TARGET("ssse3")
+	inline void load_rows1024(const unsigned char* data, __m128i* rows)
+	{
+		__m128i lo[4], hi[4];
+		for (int i = 0; i < 4; i++)
+		{
+			lo[i] = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i * 16));
+			hi[i] = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + 64 + i * 16));
+		}
+		transpose(lo);
+		transpose(hi);
+		for (int i = 0; i < 4; i++)
+		{
+			rows[2 * i] = _mm_unpacklo_epi64(lo[i], hi[i]);
+			rows[2 * i + 1] = _mm_unpackhi_epi64(lo[i], hi[i]);
+		}
+	}
+
+	DIGESTPP_TARGET("ssse3")
+	inline void store_rows1024(const __m128i* rows, unsigned char* data)
+	{
+		__m128i lo[4], hi[4];
+		for (int i = 0; i < 4; i++)
+		{
+			lo[i] = _mm_unpacklo_epi64(rows[2 * i], rows[2 * i + 1]);
+			hi[i] = _mm_unpackhi_epi64(rows[2 * i], rows[2 * i + 1]);
+		}
+		transpose(lo);
+		transpose(hi);
+		for (int i = 0; i < 4; i++)
+		{
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(data + i * 16), lo[i]);
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(data + 64 + i * 16), hi[i]);
+		}
+	}
+
+	// P512 and Q512 side by side
+	DIGESTPP_TARGET("aes,ssse3")
+	inline void permute512_aes(__m128i* x)
+	{
+		const __m128i q = _mm_set_epi64x(-1, 0);
+		for (uint64_t r = 0; r < 10; r++)
+		{
+			uint64_t rc = r * 0x0101010101010101ull;
+			x[0] = _mm_xor_si128(x[0], _mm_set_epi64x(-1, static_cast<long long>(0x7060504030201000ull ^ rc)));
+			for (int i = 1; i < 7; i++)
+				x[i] = _mm_xor_si128(x[i], q);
+			x[7] = _mm_xor_si128(x[7], _mm_set_epi64x(static_cast<long long>(0x8f9fafbfcfdfefffull ^ rc), 0));
+			sub_shift_bytes(x, shuffles<void>::PQ512);
+			mix_bytes(x);
+		}
+	}
+
+	// P1024, and Q1024 unless only_p is set
+	DIGESTPP_TARGET("aes,ssse3")
+	inline void permute1024_aes(__m128i* p, __m128i* q, bool only_p)
+	{
+		const __m128i ones = _mm_set1_epi8(-1);
+		for (uint64_t r = 0; r < 14; r++)
+		{
+			uint64_t rc = r * 0x0101010101010101ull;
+			p[0] = _mm_xor_si128(p[0], _mm_set_epi64x(static_cast<long long>(0xf0e0d0c0b0a09080ull ^ rc),
+				static_cast<long long>(0x7060504030201000ull ^ rc)));
+			sub_shift_bytes(p, shuffles<void>::P1024);
+			if (!only_p)
+			{
+				for (int i = 0; i < 7; i++)
+					q[i] = _mm_xor_si128(q[i], ones);
+				q[7] = _mm_xor_si128(q[7], _mm_set_epi64x(static_cast<long long>(0x0f1f2f3f4f5f6f7full ^ rc),
+					static_cast<long long>(0x8f9fafbfcfdfefffull ^ rc)));
+				sub_shift_bytes(q, shuffles<void>::Q1024);
+				mix_bytes(q);
+			}
+			mix_bytes(p);
+		}
+	}
+
+	// Groestl-224/256 compression function
+	DIGESTPP_TARGET("aes,ssse3")
+	inline void transform512_aes(uint64_t* h, const unsigned char* data, size_t num_blks)
+	{
+		__m128i hr[4], x[8];
+		for (int i = 0; i < 4; i++)
+			hr[i] = _mm_loadu_si128(reinterpret_cast<const __m128i*>(h + i * 2));
+		transpose(hr);
+
+		for (size_t blk = 0; blk < num_blks; blk++)
+		{
+			__m128i m[4];
+			for (int i = 0; i < 4; i++)
+				m[i] = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + blk * 64 + i * 16));
+			transpose(m);
+			for (int i = 0; i < 4; i++)
+			{
+				__m128i p = _mm_xor_si128(hr[i], m[i]);
+				x[2 * i] = _mm_unpacklo_epi64(p, m[i]);
+				x[2 * i + 1] = _mm_unpackhi_epi64(p, m[i]);
+			}
+			permute512_aes(x);
+			for (int i = 0; i < 4; i++)
+			{
+				hr[i] = _mm_xor_si128(hr[i], _mm_unpacklo_epi64(x[2 * i], x[2 * i + 1]));
+				hr[i] = _mm_xor_si128(hr[i], _mm_unpackhi_epi64(x[2 * i], x[2 * i + 1]));
+			}
+		}
+
+		transpose(hr);
+		for (int i = 0; i < 4; i++)
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(h + i * 2), hr[i]);
+	}
+
+	// Groestl-384/512 compression function
+	DIGESTPP_TARGET("aes,ssse3")
+	inline void transform1024_aes(uint64_t* h, const unsigned char* data, size_t num_blks)
+	{
+		__m128i hr[8], p[8], q[8];
+		load_rows1024(reinterpret_cast<const unsigned char*>(h), hr);
+
+		for (size_t blk = 0; blk < num_blks; blk++)
+		{
+			load_rows1024(data + blk * 128, q);
+			for (int i = 0; i < 8; i++)
+				p[i] = _mm_xor_si128(hr[i], q[i]);
+			permute1024_aes(p, q, false);
+			for (int i = 0; i < 8; i++)
+				hr[i] = _mm_xor_si128(hr[i], _mm_xor_si128(p[i], q[i]));
+		}
+
+		store_rows1024(hr, reinterpret_cast<unsigned char*>(h));
+	}
+
+	// Output transformation of Groestl-224/256; Q512 runs on a copy of the state and is ignored
+	DIGESTPP_TARGET("aes,ssse3")
+	inline void output_transform512_aes(uint64_t* h)
+	{
+		__m128i hr[4], x[8];
+		for (int i = 0; i < 4; i++)
+			hr[i] = _mm_loadu_si128(reinterpret_cast<const __m128i*>(h + i * 2));
+		transpose(hr);
+		for (int i = 0; i < 4; i++)
+		{
+			x[2 * i] = hr[i];
+			x[2 * i + 1] = _mm_unpackhi_epi64(hr[i], hr[i]);
+		}
+		permute512_aes(x);
+		for (int i = 0; i < 4; i++)
+			hr[i] = _mm_xor_si128(hr[i], _mm_unpacklo_epi64(x[2 * i], x[2 * i + 1]));
+		transpose(hr);
+		for (int i = 0; i < 4; i++)
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(h + i * 2), hr[i]);
+	}
+
+	// Output transformation of Groestl-384/512
+	DIGESTPP_TARGET("aes,ssse3")
+	inline void output_transform1024_aes(uint64_t* h)
+	{
+		__m128i hr[8], p[8];
+		load_rows1024(reinterpret_cast<const unsigned char*>(h), hr);
+		for (int i = 0; i < 8; i++)
+			p[i] = hr[i];
+		permute1024_aes(p, nullptr, true);
+		for (int i = 0; i < 8; i++)
+			hr[i] = _mm_xor_si128(hr[i], p[i]);
+		store_rows1024(hr, reinterpret_cast<unsigned char*>(h));
+	}
+#endif
+
+	// Compress num_blks blocks with the state of R 64-bit columns (8 or 16).
+	// Returns false if no kernel is available on this CPU.
+	template<int R>
+	inline bool transform(uint64_t* h, const unsigned char* data, size_t num_blks)
+	{
+#ifdef DIGESTPP_X86_SIMD
+		const cpu_features& cpu = cpu_features::get();
+		if (!cpu.aesni || !cpu.ssse3)
+			return false;
+		if (R == 16)
+			transform1024_aes(h, data, num_blks);
+		else
+			transform512_aes(h, data, num_blks);
+		return true;
+#else
+		(void)h;
+		(void)data;
+		(void)num_blks;
+		return false;
+#endif
+	}
+
+	template<int R>
+	inline bool output_transform(uint64_t* h)
+	{
+#ifdef DIGESTPP_X86_SIMD
+		const cpu_features& cpu = cpu_features::get();
+		if (!cpu.aesni || !cpu.ssse3)
+			return false;
+		if (R == 16)
+			output_transform1024_aes(h);
+		else
+			output_transform512_aes(h);
+		return true;
+#else
+		(void)h;
+		return false;
+#endif
+	}
+
+} // namespace groestl_simd
+
+} // namespace detail
+
+} // namespace digestpp
+
+#endif // DIGESTPP_PROVIDERS_GROESTL_SIMD_HPP
@@ -0,0 +1,262 @@
+/*
+This code is written by kerukuro and released into public domain.
+*/
+
+#ifndef DIGESTPP_PROVIDERS_JH_SIMD_HPP
+#define DIGESTPP_PROVIDERS_JH_SIMD_HPP
+
+#include "../../../detail/cpu_features.hpp"
+#include "../constants/jh_constants.hpp"
+#include <cstddef>
+#include <cstdint>
+
+namespace digestpp
+{
+
+namespace detail
+{
+
+namespace jh_simd
+{
+	// Bitsliced JH state is 8 128-bit words x0..x7. In each round the S-box is applied to the even words
+	// and to the odd words with different round constants, the linear transformation mixes even and odd
+	// words, and the odd words are permuted by swapping bits, bytes or halves, depending on the round modulo 7.
+	// The rounds are unrolled over these 7 permutations, so that all of them are fixed shifts and shuffles.
+	template<typename T>
+	struct shuffles
+	{
+		// Byte shuffles for the permutations of rounds 3-6 in the upper 128-bit lane (AVX2)
+		const static uint64_t SWAP[4][4];
+	};
+
+	template<typename T>
+	const uint64_t shuffles<T>::SWAP[4][4] = {
+		{ 0x0706050403020100ull, 0x0f0e0d0c0b0a0908ull, 0x0607040502030001ull, 0x0e0f0c0d0a0b0809ull },
+		{ 0x0706050403020100ull, 0x0f0e0d0c0b0a0908ull, 0x0504070601000302ull, 0x0d0c0f0e09080b0aull },
+		{ 0x0706050403020100ull, 0x0f0e0d0c0b0a0908ull, 0x0302010007060504ull, 0x0b0a09080f0e0d0cull },
+		{ 0x0706050403020100ull, 0x0f0e0d0c0b0a0908ull, 0x0f0e0d0c0b0a0908ull, 0x0706050403020100ull }
+	};
+
+	// Masks of the bit swaps in rounds 0-3
+	inline uint64_t swap_mask(int r)
+	{
+		return r == 0 ? 0x5555555555555555ull : r == 1 ? 0x3333333333333333ull
+			: r == 2 ? 0x0f0f0f0f0f0f0f0full : 0x00ff00ff00ff00ffull;
+	}
+
+#ifdef DIGESTPP_X86_SIMD
+	DIGESTPP_TARGET("sse2")
+	inline void sbox_sse2(__m128i& x0, __m128i& x1, __m128i& x2, __m128i& x3, __m128i c)
+	{
+		x3 = _mm_xor_si128(x3, _mm_set1_epi32(-1));
+		x0 = _mm_xor_si128(x0, _mm_andnot_si128(x2, c));
+		__m128i t = _mm_xor_si128(c, _mm_and_si128(x0, x1));
+		x0 = _mm_xor_si128(x0, _mm_and_si128(x2, x3));
+		x3 = _mm_xor_si128(x3, _mm_andnot_si128(x1, x2));
+		x1 = _mm_xor_si128(x1, _mm_and_si128(x0, x2));
+		x2 = _mm_xor_si128(x2, _mm_andnot_si128(x3, x0));
+		x0 = _mm_xor_si128(x0, _mm_or_si128(x1, x3));
+		x3 = _mm_xor_si128(x3, _mm_and_si128(x1, x2));
+		x1 = _mm_xor_si128(x1, _mm_and_si128(t, x0));
+		x2 = _mm_xor_si128(x2, t);
+	}
+
+	template<int r>
+	DIGESTPP_TARGET("sse2")
+	inline __m128i swap_sse2(__m128i x)
+	{
+		if (r == 4)
+			return _mm_shufflehi_epi16(_mm_shufflelo_epi16(x, 0xb1), 0xb1);
+		if (r == 5)
+			return _mm_shuffle_epi32(x, 0xb1);
+		if (r == 6)
+			return _mm_shuffle_epi32(x, 0x4e);
+		const __m128i m = _mm_set1_epi64x(static_cast<long long>(swap_mask(r)));
+		return _mm_or_si128(_mm_slli_epi64(_mm_and_si128(x, m), 1 << r), _mm_and_si128(_mm_srli_epi64(x, 1 << r), m));
+	}
+
+	template<int r>
+	DIGESTPP_TARGET("sse2")
+	inline void round_sse2(__m128i* x, const uint64_t* c)
+	{
+		sbox_sse2(x[0], x[2], x[4], x[6], _mm_loadu_si128(reinterpret_cast<const __m128i*>(c + r * 4)));
+		sbox_sse2(x[1], x[3], x[5], x[7], _mm_loadu_si128(reinterpret_cast<const __m128i*>(c + r * 4 + 2)));
+
+		x[1] = _mm_xor_si128(x[1], x[2]);
+		x[3] = _mm_xor_si128(x[3], x[4]);
+		x[5] = _mm_xor_si128(x[5], _mm_xor_si128(x[6], x[0]));
+		x[7] = _mm_xor_si128(x[7], x[0]);
+		x[0] = _mm_xor_si128(x[0], x[3]);
+		x[2] = _mm_xor_si128(x[2], x[5]);
+		x[4] = _mm_xor_si128(x[4], _mm_xor_si128(x[7], x[1]));
+		x[6] = _mm_xor_si128(x[6], x[1]);
+
+		x[1] = swap_sse2<r>(x[1]);
+		x[3] = swap_sse2<r>(x[3]);
+		x[5] = swap_sse2<r>(x[5]);
+		x[7] = swap_sse2<r>(x[7]);
+	}
+
+	DIGESTPP_TARGET("sse2")
+	inline void transform_sse2(uint64_t* H, const unsigned char* data, size_t num_blks)
+	{
+		__m128i x[8];
+		for (int i = 0; i < 8; i++)
+			x[i] = _mm_loadu_si128(reinterpret_cast<const __m128i*>(H + i * 2));
+
+		for (size_t blk = 0; blk < num_blks; blk++)
+		{
+			const __m128i* M = reinterpret_cast<const __m128i*>(data + blk * 64);
+			__m128i m[4];
+			for (int i = 0; i < 4; i++)
+			{
+				m[i] = _mm_loadu_si128(M + i);
+				x[i] = _mm_xor_si128(x[i], m[i]);
+			}
+
+			for (int r = 0; r < 42; r += 7)
+			{
+				const uint64_t* c = jh_constants<void>::C + r * 4;
+				round_sse2<0>(x, c);
+				round_sse2<1>(x, c);
+				round_sse2<2>(x, c);
+				round_sse2<3>(x, c);
+				round_sse2<4>(x, c);
+				round_sse2<5>(x, c);
+				round_sse2<6>(x, c);
+			}
+
+			for (int i = 0; i < 4; i++)
+				x[i + 4] = _mm_xor_si128(x[i + 4], m[i]);
+		}
+
+		for (int i = 0; i < 8; i++)
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(H + i * 2), x[i]);
+	}
+
+	// With AVX2 each vector holds an even word in the lower lane and the next odd word in the upper lane,
+	// which is the order of the state in memory. Both S-boxes are computed at once, and the linear
+	// transformation moves words between the lanes.
+	DIGESTPP_TARGET("avx2")
+	inline void sbox_avx2(__m256i& x0, __m256i& x1, __m256i& x2, __m256i& x3, __m256i c)
+	{
+		x3 = _mm256_xor_si256(x3, _mm256_set1_epi32(-1));
+		x0 = _mm256_xor_si256(x0, _mm256_andnot_si256(x2, c));
+		__m256i t = _mm256_xor_si256(c, _mm256_and_si256(x0, x1));
+		x0 = _mm256_xor_si256(x0, _mm256_and_si256(x2, x3));
+		x3 = _mm256_xor_si256(x3, _mm256_andnot_si256(x1, x2));
+		x1 = _mm256_xor_si256(x1, _mm256_and_si256(x0, x2));
+		x2 = _mm256_xor_si256(x2, _mm256_andnot_si256(x3, x0));
+		x0 = _mm256_xor_si256(x0, _mm256_or_si256(x1, x3));
+		x3 = _mm256_xor_si256(x3, _mm256_and_si256(x1, x2));
+		x1 = _mm256_xor_si256(x1, _mm256_and_si256(t, x0));
+		x2 = _mm256_xor_si256(x2, t);
+	}
+
+	// Permute the odd word in the upper lane
+	template<int r>
+	DIGESTPP_TARGET("avx2")
+	inline __m256i swap_avx2(__m256i x)
+	{
+		if (r >= 3)
+			return _mm256_shuffle_epi8(x, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(shuffles<void>::SWAP[r < 3 ? 0 : r - 3])));
+		const long long m = static_cast<long long>(swap_mask(r));
+		const __m256i count = _mm256_set_epi64x(1 << r, 1 << r, 0, 0);
+		__m256i lo = _mm256_and_si256(x, _mm256_set_epi64x(m, m, -1, -1));
+		__m256i hi = _mm256_and_si256(_mm256_srlv_epi64(x, count), _mm256_set_epi64x(m, m, 0, 0));
+		return _mm256_or_si256(_mm256_sllv_epi64(lo, count), hi);
+	}
+
+	template<int r>
+	DIGESTPP_TARGET("avx2")
+	inline void round_avx2(__m256i* x, const uint64_t* c)
+	{
+		sbox_avx2(x[0], x[1], x[2], x[3], _mm256_loadu_si256(reinterpret_cast<const __m256i*>(c + r * 4)));
+
+		// Odd words are updated with even words, then even words with odd words. The update of odd words
+		// is substituted in the update of even words, so that all words are updated from the swapped lanes
+		// with the same pattern, plus the even words from the lower lanes.
+		const __m256i lo = _mm256_set_epi64x(0, 0, -1, -1);
+		__m256i s0 = _mm256_permute2x128_si256(x[0], x[0], 0x01);
+		__m256i s1 = _mm256_permute2x128_si256(x[1], x[1], 0x01);
+		__m256i s2 = _mm256_permute2x128_si256(x[2], x[2], 0x01);
+		__m256i s3 = _mm256_permute2x128_si256(x[3], x[3], 0x01);
+		__m256i e0 = _mm256_and_si256(x[2], lo);
+		__m256i e1 = _mm256_and_si256(_mm256_xor_si256(x[3], x[0]), lo);
+		__m256i e2 = _mm256_and_si256(_mm256_xor_si256(x[0], x[1]), lo);
+		__m256i e3 = _mm256_and_si256(x[1], lo);
+		x[0] = _mm256_xor_si256(x[0], _mm256_xor_si256(s1, e0));
+		x[1] = _mm256_xor_si256(x[1], _mm256_xor_si256(s2, e1));
+		x[2] = _mm256_xor_si256(_mm256_xor_si256(x[2], e2), _mm256_xor_si256(s3, s0));
+		x[3] = _mm256_xor_si256(x[3], _mm256_xor_si256(s0, e3));
+
+		x[0] = swap_avx2<r>(x[0]);
+		x[1] = swap_avx2<r>(x[1]);
+		x[2] = swap_avx2<r>(x[2]);
+		x[3] = swap_avx2<r>(x[3]);
+	}
+
+	DIGESTPP_TARGET("avx2")
+	inline void transform_avx2(uint64_t* H, const unsigned char* data, size_t num_blks)
+	{
+		__m256i x[4];
+		for (int i = 0; i < 4; i++)
+			x[i] = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(H + i * 4));
+
+		for (size_t blk = 0; blk < num_blks; blk++)
+		{
+			const __m256i* M = reinterpret_cast<const __m256i*>(data + blk * 64);
+			__m256i m0 = _mm256_loadu_si256(M);
+			__m256i m1 = _mm256_loadu_si256(M + 1);
+			x[0] = _mm256_xor_si256(x[0], m0);
+			x[1] = _mm256_xor_si256(x[1], m1);
+
+			for (int r = 0; r < 42; r += 7)
+			{
+				const uint64_t* c = jh_constants<void>::C + r * 4;
+				round_avx2<0>(x, c);
+				round_avx2<1>(x, c);
+				round_avx2<2>(x, c);
+				round_avx2<3>(x, c);
+				round_avx2<4>(x, c);
+				round_avx2<5>(x, c);
+				round_avx2<6>(x, c);
+			}
+
+			x[2] = _mm256_xor_si256(x[2], m0);
+			x[3] = _mm256_xor_si256(x[3], m1);
+		}
+
+		for (int i = 0; i < 4; i++)
+			_mm256_storeu_si256(reinterpret_cast<__m256i*>(H + i * 4), x[i]);
+	}
+#endif
+
+	// Compress num_blks blocks.
+	// Returns false if no kernel is available on this CPU.
+	inline bool transform(uint64_t* H, const unsigned char* data, size_t num_blks)
+	{
+#ifdef DIGESTPP_X86_SIMD
+		const cpu_features& cpu = cpu_features::get();
+		if (cpu.avx2)
+			transform_avx2(H, data, num_blks);
+		else if (cpu.sse2)
+			transform_sse2(H, data, num_blks);
+		else
+			return false;
+		return true;
+#else
+		(void)H;
+		(void)data;
+		(void)num_blks;
+		return false;
+#endif
+	}
+
+} // namespace jh_simd
+
+} // namespace detail
+
+} // namespace digestpp
+
+#endif // DIGESTPP_PROVIDERS_JH_SIMD_HPP
@@ -0,0 +1,442 @@
+/*
+This code is written by kerukuro and released into public domain.
+*/
+
+#ifndef DIGESTPP_PROVIDERS_KUPYNA_SIMD_HPP
+#define DIGESTPP_PROVIDERS_KUPYNA_SIMD_HPP
+
+#include "../../../detail/cpu_features.hpp"
+#include "../constants/kupyna_constants.hpp"
+#include <cstddef>
+#include <cstdint>
+
+namespace digestpp
+{
+
+namespace detail
+{
+
+namespace kupyna_simd
+{
+	// Kupyna permutations with AVX-512 VBMI and GFNI. The state is transposed into rows, so that
+	// the S-box of each row (one of four) is applied with byte permutes over the 256-entry table,
+	// and the MDS matrix multiplies whole rows by constants with GF2P8AFFINEQB.
+	// Rows s and s + 4 use the same S-box and are kept in one vector:
+	//   Kupyna-256: { P row s, Q row s, P row s + 4, Q row s + 4 } (64-bit rows)
+	//   Kupyna-512: { P row s, P row s + 4, Q row s, Q row s + 4 } (128-bit rows)
+	// The round constant of Q is added to the 64-bit columns, so Q is transposed back for the addition.
+	// Other CPUs use the T-tables: with AVX2 the same layout needs 16 PSHUFB lookups in 16-byte parts
+	// of each S-box per vector, and such a kernel was slower than the tables.
+	template<typename T>
+	struct shuffles
+	{
+		// Message bytes to rows, each row twice (Kupyna-256)
+		const static unsigned char ROWS512[2][64];
+		// Q rows to columns (Kupyna-256)
+		const static unsigned char COLS512[64];
+		// ShiftBytes (Kupyna-256)
+		const static unsigned char SHIFT512[4][32];
+		// Columns to rows in the order 0, 4, 1, 5, 2, 6, 3, 7 (Kupyna-512)
+		const static unsigned char ROWS1024[2][64];
+		// Rows in the order 0, 4, 1, 5, 2, 6, 3, 7 to columns (Kupyna-512)
+		const static unsigned char COLS1024[2][64];
+		// ShiftBytes (Kupyna-512)
+		const static unsigned char SHIFT1024[4][64];
+	};
+
+	template<typename T>
+	const unsigned char shuffles<T>::ROWS512[2][64] = {
+		{
+			0, 8, 16, 24, 32, 40, 48, 56, 0, 8, 16, 24, 32, 40, 48, 56,
+			4, 12, 20, 28, 36, 44, 52, 60, 4, 12, 20, 28, 36, 44, 52, 60,
+			1, 9, 17, 25, 33, 41, 49, 57, 1, 9, 17, 25, 33, 41, 49, 57,
+			5, 13, 21, 29, 37, 45, 53, 61, 5, 13, 21, 29, 37, 45, 53, 61
+		},
+		{
+			2, 10, 18, 26, 34, 42, 50, 58, 2, 10, 18, 26, 34, 42, 50, 58,
+			6, 14, 22, 30, 38, 46, 54, 62, 6, 14, 22, 30, 38, 46, 54, 62,
+			3, 11, 19, 27, 35, 43, 51, 59, 3, 11, 19, 27, 35, 43, 51, 59,
+			7, 15, 23, 31, 39, 47, 55, 63, 7, 15, 23, 31, 39, 47, 55, 63
+		}
+	};
+
+	template<typename T>
+	const unsigned char shuffles<T>::COLS512[64] = {
+		8, 40, 72, 104, 24, 56, 88, 120, 9, 41, 73, 105, 25, 57, 89, 121,
+		10, 42, 74, 106, 26, 58, 90, 122, 11, 43, 75, 107, 27, 59, 91, 123,
+		12, 44, 76, 108, 28, 60, 92, 124, 13, 45, 77, 109, 29, 61, 93, 125,
+		14, 46, 78, 110, 30, 62, 94, 126, 15, 47, 79, 111, 31, 63, 95, 127
+	};
+
+	template<typename T>
+	const unsigned char shuffles<T>::SHIFT512[4][32] = {
+		{
+			0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15,
+			4, 5, 6, 7, 0, 1, 2, 3, 12, 13, 14, 15, 8, 9, 10, 11
+		},
+		{
+			7, 0, 1, 2, 3, 4, 5, 6, 15, 8, 9, 10, 11, 12, 13, 14,
+			3, 4, 5, 6, 7, 0, 1, 2, 11, 12, 13, 14, 15, 8, 9, 10
+		},
+		{
+			6, 7, 0, 1, 2, 3, 4, 5, 14, 15, 8, 9, 10, 11, 12, 13,
+			2, 3, 4, 5, 6, 7, 0, 1, 10, 11, 12, 13, 14, 15, 8, 9
+		},
+		{
+			5, 6, 7, 0, 1, 2, 3, 4, 13, 14, 15, 8, 9, 10, 11, 12,
+			1, 2, 3, 4, 5, 6, 7, 0, 9, 10, 11, 12, 13, 14, 15, 8
+		}
+	};
+
+	template<typename T>
+	const unsigned char shuffles<T>::ROWS1024[2][64] = {
+		{
+			0, 8, 16, 24, 32, 40, 48, 56, 64, 72, 80, 88, 96, 104, 112, 120,
+			4, 12, 20, 28, 36, 44, 52, 60, 68, 76, 84, 92, 100, 108, 116, 124,
+			1, 9, 17, 25, 33, 41, 49, 57, 65, 73, 81, 89, 97, 105, 113, 121,
+			5, 13, 21, 29, 37, 45, 53, 61, 69, 77, 85, 93, 101, 109, 117, 125
+		},
+		{
+			2, 10, 18, 26, 34, 42, 50, 58, 66, 74, 82, 90, 98, 106, 114, 122,
+			6, 14, 22, 30, 38, 46, 54, 62, 70, 78, 86, 94, 102, 110, 118, 126,
+			3, 11, 19, 27, 35, 43, 51, 59, 67, 75, 83, 91, 99, 107, 115, 123,
+			7, 15, 23, 31, 39, 47, 55, 63, 71, 79, 87, 95, 103, 111, 119, 127
+		}
+	};
+
+	template<typename T>
+	const unsigned char shuffles<T>::COLS1024[2][64] = {
+		{
+			0, 32, 64, 96, 16, 48, 80, 112, 1, 33, 65, 97, 17, 49, 81, 113,
+			2, 34, 66, 98, 18, 50, 82, 114, 3, 35, 67, 99, 19, 51, 83, 115,
+			4, 36, 68, 100, 20, 52, 84, 116, 5, 37, 69, 101, 21, 53, 85, 117,
+			6, 38, 70, 102, 22, 54, 86, 118, 7, 39, 71, 103, 23, 55, 87, 119
+		},
+		{
+			8, 40, 72, 104, 24, 56, 88, 120, 9, 41, 73, 105, 25, 57, 89, 121,
+			10, 42, 74, 106, 26, 58, 90, 122, 11, 43, 75, 107, 27, 59, 91, 123,
+			12, 44, 76, 108, 28, 60, 92, 124, 13, 45, 77, 109, 29, 61, 93, 125,
+			14, 46, 78, 110, 30, 62, 94, 126, 15, 47, 79, 111, 31, 63, 95, 127
+		}
+	};
+
+	template<typename T>
+	const unsigned char shuffles<T>::SHIFT1024[4][64] = {
+		{
+			0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15,
+			12, 13, 14, 15, 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11,
+			0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15,
+			12, 13, 14, 15, 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11
+		},
+		{
+			15, 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14,
+			11, 12, 13, 14, 15, 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10,
+			15, 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14,
+			11, 12, 13, 14, 15, 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10
+		},
+		{
+			14, 15, 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13,
+			10, 11, 12, 13, 14, 15, 0, 1, 2, 3, 4, 5, 6, 7, 8, 9,
+			14, 15, 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13,
+			10, 11, 12, 13, 14, 15, 0, 1, 2, 3, 4, 5, 6, 7, 8, 9
+		},
+		{
+			13, 14, 15, 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12,
+			5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 0, 1, 2, 3, 4,
+			13, 14, 15, 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12,
+			5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 0, 1, 2, 3, 4
+		}
+	};
+
+#ifdef DIGESTPP_X86_SIMD
+	// Apply S-box s to every byte: two lookups in 128-byte halves of the table, selected by the top bit
+	DIGESTPP_TARGET("avx512f,avx512bw,avx512vl,avx512vbmi,gfni")
+	inline __m512i sub_bytes(__m512i x, int s)
+	{
+		const unsigned char* S = kupyna_constants<void>::S[s];
+		__m512i lo = _mm512_permutex2var_epi8(_mm512_loadu_si512(S), x, _mm512_loadu_si512(S + 64));
+		__m512i hi = _mm512_permutex2var_epi8(_mm512_loadu_si512(S + 128), x, _mm512_loadu_si512(S + 192));
+		return _mm512_mask_blend_epi8(_mm512_movepi8_mask(x), lo, hi);
+	}
+
+	DIGESTPP_TARGET("avx512f,avx512bw,avx512vl,avx512vbmi,gfni")
+	inline __m256i sub_bytes(__m256i x, int s)
+	{
+		return _mm512_castsi512_si256(sub_bytes(_mm512_castsi256_si512(x), s));
+	}
+
+	// Multiplication of bytes by a constant modulo x^8 + x^4 + x^3 + x^2 + 1, as an affine transformation
+	template<uint64_t M>
+	DIGESTPP_TARGET("avx512f,avx512bw,avx512vl,avx512vbmi,gfni")
+	inline __m512i mul(__m512i x)
+	{
+		return _mm512_gf2p8affine_epi64_epi8(x, _mm512_set1_epi64(static_cast<long long>(M)), 0);
+	}
+
+	template<uint64_t M>
+	DIGESTPP_TARGET("avx512f,avx512bw,avx512vl,avx512vbmi,gfni")
+	inline __m256i mul(__m256i x)
+	{
+		return _mm256_gf2p8affine_epi64_epi8(x, _mm256_set1_epi64x(static_cast<long long>(M)), 0);
+	}
+
+	DIGESTPP_TARGET("avx512f,avx512bw,avx512vl,avx512vbmi,gfni")
+	inline __m512i vxor(__m512i a, __m512i b) { return _mm512_xor_si512(a, b); }
+
+	DIGESTPP_TARGET("avx512f,avx512bw,avx512vl,avx512vbmi,gfni")
+	inline __m256i vxor(__m256i a, __m256i b) { return _mm256_xor_si256(a, b); }
+
+	// Exchange rows s and s + 4
+	DIGESTPP_TARGET("avx512f,avx512bw,avx512vl,avx512vbmi,gfni")
+	inline __m512i swap_rows(__m512i x) { return _mm512_shuffle_i64x2(x, x, 0xb1); }
+
+	DIGESTPP_TARGET("avx512f,avx512bw,avx512vl,avx512vbmi,gfni")
+	inline __m256i swap_rows(__m256i x) { return _mm256_permute4x64_epi64(x, 0x4e); }
+
+	// Row s of MixColumns: the sum of v[k] * r[s + k] with v = { 1, 1, 5, 1, 8, 6, 7, 4 },
+	// split by powers of 2; t[i] = r[i] ^ r[i + 1]
+	template<int s, typename V>
+	DIGESTPP_TARGET("avx512f,avx512bw,avx512vl,avx512vbmi,gfni")
+	inline V mix_row(const V* r, const V* t)
+	{
+		V s1 = vxor(vxor(t[s], t[s + 2]), r[(s + 6) % 8]);
+		V s4 = vxor(vxor(r[s + 2], r[(s + 7) % 8]), t[(s + 5) % 8]);
+		V x2 = mul<0x8001828488102040ull>(t[(s + 5) % 8]);
+		V x4 = mul<0x408041c2c4881020ull>(s4);
+		V x8 = mul<0x2040a061e2c48810ull>(r[s + 4]);
+		return vxor(vxor(s1, x2), vxor(x4, x8));
+	}
+
+	// MixColumns on vectors that hold rows s and s + 4
+	template<typename V>
+	DIGESTPP_TARGET("avx512f,avx512bw,avx512vl,avx512vbmi,gfni")
+	inline void mix_columns(V* a)
+	{
+		const V r[8] = { a[0], a[1], a[2], a[3], swap_rows(a[0]), swap_rows(a[1]), swap_rows(a[2]), swap_rows(a[3]) };
+		const V t[8] = {
+			vxor(r[0], r[1]), vxor(r[1], r[2]), vxor(r[2], r[3]), vxor(r[3], r[4]),
+			vxor(r[4], r[5]), vxor(r[5], r[6]), vxor(r[6], r[7]), vxor(r[7], r[0])
+		};
+		a[0] = mix_row<0>(r, t);
+		a[1] = mix_row<1>(r, t);
+		a[2] = mix_row<2>(r, t);
+		a[3] = mix_row<3>(r, t);
+	}
+
+	// Load the columns of Kupyna-256 as rows, each row in both halves of the vectors
+	DIGESTPP_TARGET("avx512f,avx512bw,avx512vl,avx512vbmi,gfni")
+	inline void load_rows512(const unsigned char* data, __m256i* a)
+	{
+		__m512i x = _mm512_loadu_si512(data);
+		__m512i b0 = _mm512_permutexvar_epi8(_mm512_loadu_si512(shuffles<void>::ROWS512[0]), x);
+		__m512i b1 = _mm512_permutexvar_epi8(_mm512_loadu_si512(shuffles<void>::ROWS512[1]), x);
+		a[0] = _mm512_castsi512_si256(b0);
+		a[1] = _mm512_extracti64x4_epi64(b0, 1);
+		a[2] = _mm512_castsi512_si256(b1);
+		a[3] = _mm512_extracti64x4_epi64(b1, 1);
+	}
+
+	// Store the rows in the Q halves of the vectors as columns of Kupyna-256
+	DIGESTPP_TARGET("avx512f,avx512bw,avx512vl,avx512vbmi,gfni")
+	inline void store_rows512(const __m256i* a, unsigned char* data)
+	{
+		__m512i b0 = _mm512_inserti64x4(_mm512_castsi256_si512(a[0]), a[1], 1);
+		__m512i b1 = _mm512_inserti64x4(_mm512_castsi256_si512(a[2]), a[3], 1);
+		_mm512_storeu_si512(data, _mm512_permutex2var_epi8(b0, _mm512_loadu_si512(shuffles<void>::COLS512), b1));
+	}
+
+	DIGESTPP_TARGET("avx512f,avx512bw,avx512vl,avx512vbmi,gfni")
+	inline void round512_vbmi(__m256i* a, uint64_t r)
+	{
+		uint64_t rc = r * 0x0101010101010101ull;
+		a[0] = _mm256_xor_si256(a[0], _mm256_set_epi64x(0, 0, 0, static_cast<long long>(0x7060504030201000ull ^ rc)));
+
+		// Q: add the round constant to the columns
+		__m512i b0 = _mm512_inserti64x4(_mm512_castsi256_si512(a[0]), a[1], 1);
+		__m512i b1 = _mm512_inserti64x4(_mm512_castsi256_si512(a[2]), a[3], 1);
+		__m512i c = _mm512_permutex2var_epi8(b0, _mm512_loadu_si512(shuffles<void>::COLS512), b1);
+		__m512i k = _mm512_set_epi64(0x00f0f0f0f0f0f0f3ll, 0x10f0f0f0f0f0f0f3ll, 0x20f0f0f0f0f0f0f3ll, 0x30f0f0f0f0f0f0f3ll,
+			0x40f0f0f0f0f0f0f3ll, 0x50f0f0f0f0f0f0f3ll, 0x60f0f0f0f0f0f0f3ll, 0x70f0f0f0f0f0f0f3ll);
+		c = _mm512_add_epi64(c, _mm512_xor_si512(k, _mm512_set1_epi64(static_cast<long long>(r << 56))));
+		const __mmask64 q = 0xff00ff00ff00ff00ull;
+		b0 = _mm512_mask_permutexvar_epi8(b0, q, _mm512_loadu_si512(shuffles<void>::ROWS512[0]), c);
+		b1 = _mm512_mask_permutexvar_epi8(b1, q, _mm512_loadu_si512(shuffles<void>::ROWS512[1]), c);
+		a[0] = _mm512_castsi512_si256(b0);
+		a[1] = _mm512_extracti64x4_epi64(b0, 1);
+		a[2] = _mm512_castsi512_si256(b1);
+		a[3] = _mm512_extracti64x4_epi64(b1, 1);
+
+		for (int s = 0; s < 4; s++)
+			a[s] = _mm256_shuffle_epi8(sub_bytes(a[s], s), _mm256_loadu_si256(reinterpret_cast<const __m256i*>(shuffles<void>::SHIFT512[s])));
+		mix_columns(a);
+	}
+
+	// Load the columns of Kupyna-512 as rows, each row in both halves of the vectors
+	DIGESTPP_TARGET("avx512f,avx512bw,avx512vl,avx512vbmi,gfni")
+	inline void load_rows1024(const unsigned char* data, __m512i* a)
+	{
+		__m512i x0 = _mm512_loadu_si512(data);
+		__m512i x1 = _mm512_loadu_si512(data + 64);
+		__m512i q0 = _mm512_permutex2var_epi8(x0, _mm512_loadu_si512(shuffles<void>::ROWS1024[0]), x1);
+		__m512i q1 = _mm512_permutex2var_epi8(x0, _mm512_loadu_si512(shuffles<void>::ROWS1024[1]), x1);
+		a[0] = _mm512_shuffle_i64x2(q0, q0, 0x44);
+		a[1] = _mm512_shuffle_i64x2(q0, q0, 0xee);
+		a[2] = _mm512_shuffle_i64x2(q1, q1, 0x44);
+		a[3] = _mm512_shuffle_i64x2(q1, q1, 0xee);
+	}
+
+	// Store the rows in the P halves of the vectors as columns of Kupyna-512
+	DIGESTPP_TARGET("avx512f,avx512bw,avx512vl,avx512vbmi,gfni")
+	inline void store_rows1024(const __m512i* a, unsigned char* data)
+	{
+		__m512i q0 = _mm512_shuffle_i64x2(a[0], a[1], 0x44);
+		__m512i q1 = _mm512_shuffle_i64x2(a[2], a[3], 0x44);
+		_mm512_storeu_si512(data, _mm512_permutex2var_epi8(q0, _mm512_loadu_si512(shuffles<void>::COLS1024[0]), q1));
+		_mm512_storeu_si512(data + 64, _mm512_permutex2var_epi8(q0, _mm512_loadu_si512(shuffles<void>::COLS1024[1]), q1));
+	}
+
+	DIGESTPP_TARGET("avx512f,avx512bw,avx512vl,avx512vbmi,gfni")
+	inline void round1024_vbmi(__m512i* a, uint64_t r)
+	{
+		uint64_t rc = r * 0x0101010101010101ull;
+		a[0] = _mm512_xor_si512(a[0], _mm512_set_epi64(0, 0, 0, 0, 0, 0,
+			static_cast<long long>(0xf0e0d0c0b0a09080ull ^ rc), static_cast<long long>(0x7060504030201000ull ^ rc)));
+
+		// Q: add the round constant to the columns
+		__m512i q0 = _mm512_shuffle_i64x2(a[0], a[1], 0xee);
+		__m512i q1 = _mm512_shuffle_i64x2(a[2], a[3], 0xee);
+		__m512i c0 = _mm512_permutex2var_epi8(q0, _mm512_loadu_si512(shuffles<void>::COLS1024[0]), q1);
+		__m512i c1 = _mm512_permutex2var_epi8(q0, _mm512_loadu_si512(shuffles<void>::COLS1024[1]), q1);
+		__m512i k = _mm512_set_epi64(0x00f0f0f0f0f0f0f3ll, 0x10f0f0f0f0f0f0f3ll, 0x20f0f0f0f0f0f0f3ll, 0x30f0f0f0f0f0f0f3ll,
+			0x40f0f0f0f0f0f0f3ll, 0x50f0f0f0f0f0f0f3ll, 0x60f0f0f0f0f0f0f3ll, 0x70f0f0f0f0f0f0f3ll);
+		k = _mm512_xor_si512(k, _mm512_set1_epi64(static_cast<long long>(r << 56)));
+		c0 = _mm512_add_epi64(c0, _mm512_xor_si512(k, _mm512_set1_epi64(static_cast<long long>(0x8ull << 60))));
+		c1 = _mm512_add_epi64(c1, k);
+		q0 = _mm512_permutex2var_epi8(c0, _mm512_loadu_si512(shuffles<void>::ROWS1024[0]), c1);
+		q1 = _mm512_permutex2var_epi8(c0, _mm512_loadu_si512(shuffles<void>::ROWS1024[1]), c1);
+		a[0] = _mm512_shuffle_i64x2(a[0], q0, 0x44);
+		a[1] = _mm512_shuffle_i64x2(a[1], q0, 0xe4);
+		a[2] = _mm512_shuffle_i64x2(a[2], q1, 0x44);
+		a[3] = _mm512_shuffle_i64x2(a[3], q1, 0xe4);
+
+		for (int s = 0; s < 4; s++)
+			a[s] = _mm512_shuffle_epi8(sub_bytes(a[s], s), _mm512_loadu_si512(shuffles<void>::SHIFT1024[s]));
+		mix_columns(a);
+	}
+
+	// Kupyna-256 compression function
+	DIGESTPP_TARGET("avx512f,avx512bw,avx512vl,avx512vbmi,gfni")
+	inline void transform512_vbmi(uint64_t* h, const unsigned char* data, size_t num_blks)
+	{
+		__m256i hr[4], a[4];
+		load_rows512(reinterpret_cast<const unsigned char*>(h), hr);
+		for (size_t blk = 0; blk < num_blks; blk++)
+		{
+			load_rows512(data + blk * 64, a);
+			for (int s = 0; s < 4; s++)
+				a[s] = _mm256_mask_xor_epi64(a[s], 0x05, a[s], hr[s]);
+			for (uint64_t r = 0; r < 10; r++)
+				round512_vbmi(a, r);
+			for (int s = 0; s < 4; s++)
+				hr[s] = _mm256_xor_si256(hr[s], _mm256_xor_si256(a[s], _mm256_shuffle_epi32(a[s], 0x4e)));
+		}
+		store_rows512(hr, reinterpret_cast<unsigned char*>(h));
+	}
+
+	// Kupyna-512 compression function
+	DIGESTPP_TARGET("avx512f,avx512bw,avx512vl,avx512vbmi,gfni")
+	inline void transform1024_vbmi(uint64_t* h, const unsigned char* data, size_t num_blks)
+	{
+		__m512i hr[4], a[4];
+		load_rows1024(reinterpret_cast<const unsigned char*>(h), hr);
+		for (size_t blk = 0; blk < num_blks; blk++)
+		{
+			load_rows1024(data + blk * 128, a);
+			for (int s = 0; s < 4; s++)
+				a[s] = _mm512_mask_xor_epi64(a[s], 0x0f, a[s], hr[s]);
+			for (uint64_t r = 0; r < 14; r++)
+				round1024_vbmi(a, r);
+			for (int s = 0; s < 4; s++)
+				hr[s] = _mm512_xor_si512(hr[s], _mm512_xor_si512(a[s], _mm512_shuffle_i64x2(a[s], a[s], 0x4e)));
+		}
+		store_rows1024(hr, reinterpret_cast<unsigned char*>(h));
+	}
+
+	// Output transformation of Kupyna-256; the Q halves are ignored
+	DIGESTPP_TARGET("avx512f,avx512bw,avx512vl,avx512vbmi,gfni")
+	inline void output_transform512_vbmi(uint64_t* h)
+	{
+		__m256i hr[4], a[4];
+		load_rows512(reinterpret_cast<const unsigned char*>(h), hr);
+		for (int s = 0; s < 4; s++)
+			a[s] = hr[s];
+		for (uint64_t r = 0; r < 10; r++)
+			round512_vbmi(a, r);
+		for (int s = 0; s < 4; s++)
+			hr[s] = _mm256_xor_si256(hr[s], _mm256_unpacklo_epi64(a[s], a[s]));
+		store_rows512(hr, reinterpret_cast<unsigned char*>(h));
+	}
+
+	// Output transformation of Kupyna-512; the Q halves are ignored
+	DIGESTPP_TARGET("avx512f,avx512bw,avx512vl,avx512vbmi,gfni")
+	inline void output_transform1024_vbmi(uint64_t* h)
+	{
+		__m512i hr[4], a[4];
+		load_rows1024(reinterpret_cast<const unsigned char*>(h), hr);
+		for (int s = 0; s < 4; s++)
+			a[s] = hr[s];
+		for (uint64_t r = 0; r < 14; r++)
+			round1024_vbmi(a, r);
+		for (int s = 0; s < 4; s++)
+			hr[s] = _mm512_xor_si512(hr[s], _mm512_shuffle_i64x2(a[s], a[s], 0x44));
+		store_rows1024(hr, reinterpret_cast<unsigned char*>(h));
+	}
+#endif
+
+	// Compress num_blks blocks with the state of R 64-bit columns (8 or 16).
+	// Returns false if no kernel is available on this CPU.
+	template<int R>
+	inline bool transform(uint64_t* h, const unsigned char* data, size_t num_blks)
+	{
+#ifdef DIGESTPP_X86_SIMD
+		const cpu_features& cpu = cpu_features::get();
+		if (!cpu.vbmi || !cpu.gfni)
+			return false;
+		if (R == 16)
+			transform1024_vbmi(h, data, num_blks);
+		else
+			transform512_vbmi(h, data, num_blks);
+		return true;
+#else
+		(void)h;
+		(void)data;
+		(void)num_blks;
+		return false;
+#endif
+	}
+
+	template<int R>
+	inline bool output_transform(uint64_t* h)
+	{
+#ifdef DIGESTPP_X86_SIMD
+		const cpu_features& cpu = cpu_features::get();
+		if (!cpu.vbmi || !cpu.gfni)
+			return false;
+		if (R == 16)
+			output_transform1024_vbmi(h);
+		else
+			output_transform512_vbmi(h);
+		return true;
+#else
+		(void)h;
+		return false;
+#endif
+	}
+
+} // namespace kupyna_simd
+
+} // namespace detail
+
+} // namespace digestpp
+
+#endif // DIGESTPP_PROVIDERS_KUPYNA_SIMD_HPP
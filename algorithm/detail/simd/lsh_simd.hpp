@@ -0,0 +1,232 @@
+/*
+This code is written by kerukuro and released into public domain.
+*/
+
+#ifndef DIGESTPP_PROVIDERS_LSH_SIMD_HPP
+#define DIGESTPP_PROVIDERS_LSH_SIMD_HPP
+
+#include "../../../detail/cpu_features.hpp"
+#include "../constants/lsh_constants.hpp"
+#include <cstddef>
+#include <cstdint>
+
+namespace digestpp
+{
+
+namespace detail
+{
+
+namespace lsh_simd
+{
+	// LSH compression with AVX2. The chaining variable is split into the left half (words 0-7) and
+	// the right half (words 8-15), which are mixed with each other lane by lane, so every step is a few
+	// vector additions and rotations. The rotations by gamma are by whole bytes and are done with byte shuffles,
+	// merged with the word permutation for LSH-256. The message expansion is computed step by step in registers.
+	template<typename T>
+	struct shuffles
+	{
+		// Word permutation of the message expansion (LSH-256)
+		const static uint64_t TAU256[4];
+		// Rotations by gamma of the right half and its word permutation (LSH-256)
+		const static uint64_t GAMMA256[4];
+		// Rotations by gamma of words 8-11 and 12-15 (LSH-512)
+		const static uint64_t GAMMA512[2][4];
+	};
+
+	template<typename T>
+	const uint64_t shuffles<T>::TAU256[4] = {
+		0x0b0a09080f0e0d0cull, 0x0706050403020100ull, 0x030201000f0e0d0cull, 0x0b0a090807060504ull
+	};
+
+	template<typename T>
+	const uint64_t shuffles<T>::GAMMA256[4] = {
+		0x0c0f0e0d03020100ull, 0x0605040709080b0aull, 0x0f0e0d0c00030201ull, 0x050407060a09080bull
+	};
+
+	template<typename T>
+	const uint64_t shuffles<T>::GAMMA512[2][4] = {
+		{ 0x0706050403020100ull, 0x0d0c0b0a09080f0eull, 0x0302010007060504ull, 0x09080f0e0d0c0b0aull },
+		{ 0x0605040302010007ull, 0x0c0b0a09080f0e0dull, 0x0201000706050403ull, 0x080f0e0d0c0b0a09ull }
+	};
+
+#ifdef DIGESTPP_X86_SIMD
+	template<int n>
+	DIGESTPP_TARGET("avx2")
+	inline __m256i rotl32(__m256i x)
+	{
+		return _mm256_or_si256(_mm256_slli_epi32(x, n), _mm256_srli_epi32(x, 32 - n));
+	}
+
+	template<int n>
+	DIGESTPP_TARGET("avx2")
+	inline __m256i rotl64(__m256i x)
+	{
+		return _mm256_or_si256(_mm256_slli_epi64(x, n), _mm256_srli_epi64(x, 64 - n));
+	}
+
+	DIGESTPP_TARGET("avx2")
+	inline __m256i load_shuffle(const uint64_t* s)
+	{
+		return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(s));
+	}
+
+	// Step of LSH-256 with message words m (left half) and m + 8 (right half)
+	template<int alpha, int beta>
+	DIGESTPP_TARGET("avx2")
+	inline void step256(__m256i& l, __m256i& r, __m256i ml, __m256i mr, const uint32_t* sc)
+	{
+		__m256i x = _mm256_xor_si256(l, ml);
+		__m256i y = _mm256_xor_si256(r, mr);
+		x = _mm256_xor_si256(rotl32<alpha>(_mm256_add_epi32(x, y)), _mm256_loadu_si256(reinterpret_cast<const __m256i*>(sc)));
+		y = rotl32<beta>(_mm256_add_epi32(x, y));
+		x = _mm256_shuffle_epi32(_mm256_add_epi32(x, y), 0xd2);
+		y = _mm256_shuffle_epi8(y, load_shuffle(shuffles<void>::GAMMA256));
+		l = _mm256_permute2x128_si256(x, y, 0x31);
+		r = _mm256_permute2x128_si256(x, y, 0x20);
+	}
+
+	DIGESTPP_TARGET("avx2")
+	inline void transform256_avx2(uint32_t* cv, const unsigned char* data, size_t num_blks)
+	{
+		const __m256i* mp = reinterpret_cast<const __m256i*>(data);
+		const __m256i tau = load_shuffle(shuffles<void>::TAU256);
+		__m256i l = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(cv));
+		__m256i r = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(cv + 8));
+
+		for (size_t blk = 0; blk < num_blks; blk++, mp += 4)
+		{
+			// Message words of steps i and i + 1
+			__m256i al = _mm256_loadu_si256(mp), ar = _mm256_loadu_si256(mp + 1);
+			__m256i bl = _mm256_loadu_si256(mp + 2), br = _mm256_loadu_si256(mp + 3);
+			for (int i = 0; i < 26; i += 2)
+			{
+				step256<29, 1>(l, r, al, ar, lsh_constants<void>::SC256[i]);
+				step256<5, 17>(l, r, bl, br, lsh_constants<void>::SC256[i + 1]);
+				al = _mm256_add_epi32(bl, _mm256_shuffle_epi8(al, tau));
+				ar = _mm256_add_epi32(br, _mm256_shuffle_epi8(ar, tau));
+				bl = _mm256_add_epi32(al, _mm256_shuffle_epi8(bl, tau));
+				br = _mm256_add_epi32(ar, _mm256_shuffle_epi8(br, tau));
+			}
+			l = _mm256_xor_si256(l, al);
+			r = _mm256_xor_si256(r, ar);
+		}
+
+		_mm256_storeu_si256(reinterpret_cast<__m256i*>(cv), l);
+		_mm256_storeu_si256(reinterpret_cast<__m256i*>(cv + 8), r);
+	}
+
+	// Step of LSH-512; the left half is in l0, l1 and the right half in r0, r1
+	template<int alpha, int beta>
+	DIGESTPP_TARGET("avx2")
+	inline void step512(__m256i* l, __m256i* r, const __m256i* m, const uint64_t* sc)
+	{
+		__m256i x[2], y[2];
+		for (int i = 0; i < 2; i++)
+		{
+			x[i] = _mm256_xor_si256(l[i], m[i]);
+			y[i] = _mm256_xor_si256(r[i], m[i + 2]);
+			x[i] = _mm256_xor_si256(rotl64<alpha>(_mm256_add_epi64(x[i], y[i])),
+				_mm256_loadu_si256(reinterpret_cast<const __m256i*>(sc + i * 4)));
+			y[i] = rotl64<beta>(_mm256_add_epi64(x[i], y[i]));
+			x[i] = _mm256_add_epi64(x[i], y[i]);
+			y[i] = _mm256_shuffle_epi8(y[i], load_shuffle(shuffles<void>::GAMMA512[i]));
+		}
+		l[0] = _mm256_permute4x64_epi64(x[1], 0xd2);
+		l[1] = _mm256_permute4x64_epi64(y[1], 0x6c);
+		r[0] = _mm256_permute4x64_epi64(x[0], 0xd2);
+		r[1] = _mm256_permute4x64_epi64(y[0], 0x6c);
+	}
+
+	// Next message words: a + tau(b)
+	DIGESTPP_TARGET("avx2")
+	inline void expand512(__m256i* a, const __m256i* b)
+	{
+		a[0] = _mm256_add_epi64(b[0], _mm256_permute4x64_epi64(a[0], 0x4b));
+		a[1] = _mm256_add_epi64(b[1], _mm256_permute4x64_epi64(a[1], 0x93));
+		a[2] = _mm256_add_epi64(b[2], _mm256_permute4x64_epi64(a[2], 0x4b));
+		a[3] = _mm256_add_epi64(b[3], _mm256_permute4x64_epi64(a[3], 0x93));
+	}
+
+	DIGESTPP_TARGET("avx2")
+	inline void transform512_avx2(uint64_t* cv, const unsigned char* data, size_t num_blks)
+	{
+		const __m256i* mp = reinterpret_cast<const __m256i*>(data);
+		__m256i l[2], r[2];
+		for (int i = 0; i < 2; i++)
+		{
+			l[i] = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(cv + i * 4));
+			r[i] = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(cv + 8 + i * 4));
+		}
+
+		for (size_t blk = 0; blk < num_blks; blk++, mp += 8)
+		{
+			// Message words of steps i and i + 1
+			__m256i a[4], b[4];
+			for (int i = 0; i < 4; i++)
+			{
+				a[i] = _mm256_loadu_si256(mp + i);
+				b[i] = _mm256_loadu_si256(mp + 4 + i);
+			}
+			for (int i = 0; i < 28; i += 2)
+			{
+				step512<23, 59>(l, r, a, lsh_constants<void>::SC512[i]);
+				step512<7, 3>(l, r, b, lsh_constants<void>::SC512[i + 1]);
+				expand512(a, b);
+				expand512(b, a);
+			}
+			for (int i = 0; i < 2; i++)
+			{
+				l[i] = _mm256_xor_si256(l[i], a[i]);
+				r[i] = _mm256_xor_si256(r[i], a[i + 2]);
+			}
+		}
+
+		for (int i = 0; i < 2; i++)
+		{
+			_mm256_storeu_si256(reinterpret_cast<__m256i*>(cv + i * 4), l[i]);
+			_mm256_storeu_si256(reinterpret_cast<__m256i*>(cv + 8 + i * 4), r[i]);
+		}
+	}
+#endif
+
+	// Compress num_blks blocks of LSH-256.
+	// Returns false if no kernel is available on this CPU.
+	inline bool transform(uint32_t* cv, const unsigned char* data, size_t num_blks)
+	{
+#ifdef DIGESTPP_X86_SIMD
+		if (!cpu_features::get().avx2)
+			return false;
+		transform256_avx2(cv, data, num_blks);
+		return true;
+#else
+		(void)cv;
+		(void)data;
+		(void)num_blks;
+		return false;
+#endif
+	}
+
+	// Compress num_blks blocks of LSH-512.
+	// Returns false if no kernel is available on this CPU.
+	inline bool transform(uint64_t* cv, const unsigned char* data, size_t num_blks)
+	{
+#ifdef DIGESTPP_X86_SIMD
+		if (!cpu_features::get().avx2)
+			return false;
+		transform512_avx2(cv, data, num_blks);
+		return true;
+#else
+		(void)cv;
+		(void)data;
+		(void)num_blks;
+		return false;
+#endif
+	}
+
+} // namespace lsh_simd
+
+} // namespace detail
+
+} // namespace digestpp
+
+#endif // DIGESTPP_PROVIDERS_LSH_SIMD_HPP
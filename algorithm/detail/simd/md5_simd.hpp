@@ -0,0 +1,203 @@
+/*
+This code is written by kerukuro and released into public domain.
+*/
+
+#ifndef DIGESTPP_PROVIDERS_MD5_SIMD_HPP
+#define DIGESTPP_PROVIDERS_MD5_SIMD_HPP
+
+#include "../../../detail/cpu_features.hpp"
+#include "../constants/md5_constants.hpp"
+#include "../multi_buffer.hpp"
+#include <cstddef>
+#include <cstdint>
+
+namespace digestpp
+{
+
+namespace detail
+{
+
+namespace md5_simd
+{
+	// Index of the message word used in round t of group f
+	template<int f>
+	inline int message_index(int t)
+	{
+		return f == 0 ? t : f == 1 ? (5 * t + 1) % 16 : f == 2 ? (3 * t + 5) % 16 : (7 * t) % 16;
+	}
+
+#ifdef DIGESTPP_X86_SIMD
+	// Multi-buffer MD5: each vector element belongs to a different message.
+	// The state is stored as state[word * lanes + lane], so that one vector holds a word of all lanes.
+	// The rounds of one message form a single dependency chain, so lanes are the only source of parallelism.
+
+	template<int f>
+	DIGESTPP_TARGET("avx2")
+	inline __m256i func_avx2(__m256i b, __m256i c, __m256i d)
+	{
+		if (f == 0)
+			return _mm256_xor_si256(d, _mm256_and_si256(b, _mm256_xor_si256(c, d)));
+		// (d & b) | (~d & c): the andnot does not depend on b, the word computed in the previous round
+		if (f == 1)
+			return _mm256_or_si256(_mm256_and_si256(d, b), _mm256_andnot_si256(d, c));
+		if (f == 2)
+			return _mm256_xor_si256(_mm256_xor_si256(b, c), d);
+		return _mm256_xor_si256(c, _mm256_or_si256(b, _mm256_xor_si256(d, _mm256_set1_epi32(-1))));
+	}
+
+	template<int f, int s>
+	DIGESTPP_TARGET("avx2")
+	inline void step_avx2(__m256i& a, __m256i b, __m256i c, __m256i d, uint32_t k, __m256i m)
+	{
+		// a + m + k does not depend on the previous round
+		__m256i x = _mm256_add_epi32(a, _mm256_add_epi32(m, _mm256_set1_epi32(static_cast<int>(k))));
+		x = _mm256_add_epi32(x, func_avx2<f>(b, c, d));
+		a = _mm256_add_epi32(b, _mm256_or_si256(_mm256_slli_epi32(x, s), _mm256_srli_epi32(x, 32 - s)));
+	}
+
+	// 16 rounds of group f; s0..s3 are the rotation amounts of the group
+	template<int f, int s0, int s1, int s2, int s3>
+	DIGESTPP_TARGET("avx2")
+	inline void rounds_avx2(__m256i* s, const __m256i* M)
+	{
+		const uint32_t* K = md5_constants<void>::K;
+		__m256i a = s[0], b = s[1], c = s[2], d = s[3];
+		for (int t = f * 16; t < f * 16 + 16; t += 4)
+		{
+			step_avx2<f, s0>(a, b, c, d, K[t], M[message_index<f>(t)]);
+			step_avx2<f, s1>(d, a, b, c, K[t + 1], M[message_index<f>(t + 1)]);
+			step_avx2<f, s2>(c, d, a, b, K[t + 2], M[message_index<f>(t + 2)]);
+			step_avx2<f, s3>(b, c, d, a, K[t + 3], M[message_index<f>(t + 3)]);
+		}
+		s[0] = a;
+		s[1] = b;
+		s[2] = c;
+		s[3] = d;
+	}
+
+	// Compress one block in each of 8 lanes
+	DIGESTPP_TARGET("avx2")
+	inline void transform_x8_avx2(uint32_t* state, const unsigned char* const* blocks)
+	{
+		__m256i M[16];
+		multi_buffer::load_words_avx2<false>(blocks, 0, M);
+		multi_buffer::load_words_avx2<false>(blocks, 32, M + 8);
+
+		__m256i S[4];
+		for (int i = 0; i < 4; i++)
+			S[i] = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(state + i * 8));
+		__m256i R[4] = { S[0], S[1], S[2], S[3] };
+		rounds_avx2<0, 7, 12, 17, 22>(R, M);
+		rounds_avx2<1, 5, 9, 14, 20>(R, M);
+		rounds_avx2<2, 4, 11, 16, 23>(R, M);
+		rounds_avx2<3, 6, 10, 15, 21>(R, M);
+		for (int i = 0; i < 4; i++)
+			_mm256_storeu_si256(reinterpret_cast<__m256i*>(state + i * 8), _mm256_add_epi32(S[i], R[i]));
+	}
+
+	template<int f>
+	DIGESTPP_TARGET("avx512f,avx512bw,avx512vl")
+	inline __m512i func_avx512(__m512i b, __m512i c, __m512i d)
+	{
+		if (f == 0)
+			return _mm512_ternarylogic_epi32(b, c, d, 0xca);
+		if (f == 1)
+			return _mm512_ternarylogic_epi32(d, b, c, 0xca);
+		if (f == 2)
+			return _mm512_ternarylogic_epi32(b, c, d, 0x96);
+		return _mm512_ternarylogic_epi32(b, c, d, 0x39);
+	}
+
+	template<int f, int s>
+	DIGESTPP_TARGET("avx512f,avx512bw,avx512vl")
+	inline void step_avx512(__m512i& a, __m512i b, __m512i c, __m512i d, uint32_t k, __m512i m)
+	{
+		// a + m + k does not depend on the previous round
+		__m512i x = _mm512_add_epi32(a, _mm512_add_epi32(m, _mm512_set1_epi32(static_cast<int>(k))));
+		x = _mm512_add_epi32(x, func_avx512<f>(b, c, d));
+		a = _mm512_add_epi32(b, _mm512_rol_epi32(x, s));
+	}
+
+	template<int f, int s0, int s1, int s2, int s3>
+	DIGESTPP_TARGET("avx512f,avx512bw,avx512vl")
+	inline void rounds_avx512(__m512i* s, const __m512i* M)
+	{
+		const uint32_t* K = md5_constants<void>::K;
+		__m512i a = s[0], b = s[1], c = s[2], d = s[3];
+		for (int t = f * 16; t < f * 16 + 16; t += 4)
+		{
+			step_avx512<f, s0>(a, b, c, d, K[t], M[message_index<f>(t)]);
+			step_avx512<f, s1>(d, a, b, c, K[t + 1], M[message_index<f>(t + 1)]);
+			step_avx512<f, s2>(c, d, a, b, K[t + 2], M[message_index<f>(t + 2)]);
+			step_avx512<f, s3>(b, c, d, a, K[t + 3], M[message_index<f>(t + 3)]);
+		}
+		s[0] = a;
+		s[1] = b;
+		s[2] = c;
+		s[3] = d;
+	}
+
+	// Compress one block in each of 16 lanes
+	DIGESTPP_TARGET("avx512f,avx512bw,avx512vl")
+	inline void transform_x16_avx512(uint32_t* state, const unsigned char* const* blocks)
+	{
+		__m512i M[16];
+		multi_buffer::load_words_avx512<false>(blocks, M);
+
+		__m512i S[4];
+		for (int i = 0; i < 4; i++)
+			S[i] = _mm512_loadu_si512(state + i * 16);
+		__m512i R[4] = { S[0], S[1], S[2], S[3] };
+		rounds_avx512<0, 7, 12, 17, 22>(R, M);
+		rounds_avx512<1, 5, 9, 14, 20>(R, M);
+		rounds_avx512<2, 4, 11, 16, 23>(R, M);
+		rounds_avx512<3, 6, 10, 15, 21>(R, M);
+		for (int i = 0; i < 4; i++)
+			_mm512_storeu_si512(state + i * 16, _mm512_add_epi32(S[i], R[i]));
+	}
+#endif
+
+	struct md5_batch_traits
+	{
+		static const size_t words = 4;
+		static const size_t digest_size = 16;
+		static const bool big_endian = false;
+		static const uint32_t* iv()
+		{
+			static const uint32_t H[4] = { 0x67452301, 0xefcdab89, 0x98badcfe, 0x10325476 };
+			return H;
+		}
+	};
+
+	// Compute MD5 of count messages with the multi-buffer kernel for this CPU.
+	// Returns false if there is none, in which case the caller hashes the messages one by one.
+	inline bool hash_batch(const unsigned char* const* data, const size_t* len, size_t count, unsigned char* out)
+	{
+#ifdef DIGESTPP_X86_SIMD
+		const cpu_features& cpu = cpu_features::get();
+		if (cpu.avx512)
+		{
+			multi_buffer::hash<16, md5_batch_traits>(data, len, count, out, transform_x16_avx512);
+			return true;
+		}
+		if (cpu.avx2)
+		{
+			multi_buffer::hash<8, md5_batch_traits>(data, len, count, out, transform_x8_avx2);
+			return true;
+		}
+#else
+		(void)data;
+		(void)len;
+		(void)count;
+		(void)out;
+#endif
+		return false;
+	}
+
+} // namespace md5_simd
+
+} // namespace detail
+
+} // namespace digestpp
+
+#endif // DIGESTPP_PROVIDERS_MD5_SIMD_HPP
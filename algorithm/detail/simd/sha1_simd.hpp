@@ -0,0 +1,389 @@
+/*
+This code is written by kerukuro and released into public domain.
+*/
+
+#ifndef DIGESTPP_PROVIDERS_SHA1_SIMD_HPP
+#define DIGESTPP_PROVIDERS_SHA1_SIMD_HPP
+
+#include "../../../detail/cpu_features.hpp"
+#include "../constants/sha1_constants.hpp"
+#include "../multi_buffer.hpp"
+#include <cstddef>
+#include <cstdint>
+
+namespace digestpp
+{
+
+namespace detail
+{
+
+namespace sha1_simd
+{
+
+#ifdef DIGESTPP_X86_SIMD
+	// SHA-1 compression using SHA extensions.
+	// The instructions keep A-D in one register with A in the highest word and E in the highest word of another.
+	// Each sha1rnds4 performs four rounds, sha1nexte computes E for the next four rounds and adds it to the
+	// message words, and sha1msg1/sha1msg2 compute the message schedule four words at a time.
+	DIGESTPP_TARGET("sha,sse4.1")
+	inline void transform_shani(uint32_t* H, const unsigned char* data, size_t num_blks)
+	{
+		const __m128i mask = _mm_set_epi64x(0x0001020304050607ull, 0x08090a0b0c0d0e0full);
+
+		__m128i abcd = _mm_shuffle_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(H)), 0x1b);
+		__m128i e0 = _mm_set_epi32(static_cast<int>(H[4]), 0, 0, 0);
+
+		for (size_t blk = 0; blk < num_blks; blk++, data += 64)
+		{
+			__m128i abcd_save = abcd;
+			__m128i e_save = e0;
+			__m128i e1, m0, m1, m2, m3;
+
+			// Rounds 0-3
+			m0 = _mm_shuffle_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(data + 0)), mask);
+			e0 = _mm_add_epi32(e0, m0);
+			e1 = abcd;
+			abcd = _mm_sha1rnds4_epu32(abcd, e0, 0);
+
+			// Rounds 4-7
+			m1 = _mm_shuffle_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(data + 16)), mask);
+			e1 = _mm_sha1nexte_epu32(e1, m1);
+			e0 = abcd;
+			abcd = _mm_sha1rnds4_epu32(abcd, e1, 0);
+			m0 = _mm_sha1msg1_epu32(m0, m1);
+
+			// Rounds 8-11
+			m2 = _mm_shuffle_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(data + 32)), mask);
+			e0 = _mm_sha1nexte_epu32(e0, m2);
+			e1 = abcd;
+			abcd = _mm_sha1rnds4_epu32(abcd, e0, 0);
+			m1 = _mm_sha1msg1_epu32(m1, m2);
+			m0 = _mm_xor_si128(m0, m2);
+
+			// Rounds 12-15
+			m3 = _mm_shuffle_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(data + 48)), mask);
+			e1 = _mm_sha1nexte_epu32(e1, m3);
+			e0 = abcd;
+			m0 = _mm_sha1msg2_epu32(m0, m3);
+			abcd = _mm_sha1rnds4_epu32(abcd, e1, 0);
+			m2 = _mm_sha1msg1_epu32(m2, m3);
+			m1 = _mm_xor_si128(m1, m3);
+
+			// Rounds 16-19
+			e0 = _mm_sha1nexte_epu32(e0, m0);
+			e1 = abcd;
+			m1 = _mm_sha1msg2_epu32(m1, m0);
+			abcd = _mm_sha1rnds4_epu32(abcd, e0, 0);
+			m3 = _mm_sha1msg1_epu32(m3, m0);
+			m2 = _mm_xor_si128(m2, m0);
+
+			// Rounds 20-23
+			e1 = _mm_sha1nexte_epu32(e1, m1);
+			e0 = abcd;
+			m2 = _mm_sha1msg2_epu32(m2, m1);
+			abcd = _mm_sha1rnds4_epu32(abcd, e1, 1);
+			m0 = _mm_sha1msg1_epu32(m0, m1);
+			m3 = _mm_xor_si128(m3, m1);
+
+			// Rounds 24-27
+			e0 = _mm_sha1nexte_epu32(e0, m2);
+			e1 = abcd;
+			m3 = _mm_sha1msg2_epu32(m3, m2);
+			abcd = _mm_sha1rnds4_epu32(abcd, e0, 1);
+			m1 = _mm_sha1msg1_epu32(m1, m2);
+			m0 = _mm_xor_si128(m0, m2);
+
+			// Rounds 28-31
+			e1 = _mm_sha1nexte_epu32(e1, m3);
+			e0 = abcd;
+			m0 = _mm_sha1msg2_epu32(m0, m3);
+			abcd = _mm_sha1rnds4_epu32(abcd, e1, 1);
+			m2 = _mm_sha1msg1_epu32(m2, m3);
+			m1 = _mm_xor_si128(m1, m3);
+
+			// Rounds 32-35
+			e0 = _mm_sha1nexte_epu32(e0, m0);
+			e1 = abcd;
+			m1 = _mm_sha1msg2_epu32(m1, m0);
+			abcd = _mm_sha1rnds4_epu32(abcd, e0, 1);
+			m3 = _mm_sha1msg1_epu32(m3, m0);
+			m2 = _mm_xor_si128(m2, m0);
+
+			// Rounds 36-39
+			e1 = _mm_sha1nexte_epu32(e1, m1);
+			e0 = abcd;
+			m2 = _mm_sha1msg2_epu32(m2, m1);
+			abcd = _mm_sha1rnds4_epu32(abcd, e1, 1);
+			m0 = _mm_sha1msg1_epu32(m0, m1);
+			m3 = _mm_xor_si128(m3, m1);
+
+			// Rounds 40-43
+			e0 = _mm_sha1nexte_epu32(e0, m2);
+			e1 = abcd;
+			m3 = _mm_sha1msg2_epu32(m3, m2);
+			abcd = _mm_sha1rnds4_epu32(abcd, e0, 2);
+			m1 = _mm_sha1msg1_epu32(m1, m2);
+			m0 = _mm_xor_si128(m0, m2);
+
+			// Rounds 44-47
+			e1 = _mm_sha1nexte_epu32(e1, m3);
+			e0 = abcd;
+			m0 = _mm_sha1msg2_epu32(m0, m3);
+			abcd = _mm_sha1rnds4_epu32(abcd, e1, 2);
+			m2 = _mm_sha1msg1_epu32(m2, m3);
+			m1 = _mm_xor_si128(m1, m3);
+
+			// Rounds 48-51
+			e0 = _mm_sha1nexte_epu32(e0, m0);
+			e1 = abcd;
+			m1 = _mm_sha1msg2_epu32(m1, m0);
+			abcd = _mm_sha1rnds4_epu32(abcd, e0, 2);
+			m3 = _mm_sha1msg1_epu32(m3, m0);
+			m2 = _mm_xor_si128(m2, m0);
+
+			// Rounds 52-55
+			e1 = _mm_sha1nexte_epu32(e1, m1);
+			e0 = abcd;
+			m2 = _mm_sha1msg2_epu32(m2, m1);
+			abcd = _mm_sha1rnds4_epu32(abcd, e1, 2);
+			m0 = _mm_sha1msg1_epu32(m0, m1);
+			m3 = _mm_xor_si128(m3, m1);
+
+			// Rounds 56-59
+			e0 = _mm_sha1nexte_epu32(e0, m2);
+			e1 = abcd;
+			m3 = _mm_sha1msg2_epu32(m3, m2);
+			abcd = _mm_sha1rnds4_epu32(abcd, e0, 2);
+			m1 = _mm_sha1msg1_epu32(m1, m2);
+			m0 = _mm_xor_si128(m0, m2);
+
+			// Rounds 60-63
+			e1 = _mm_sha1nexte_epu32(e1, m3);
+			e0 = abcd;
+			m0 = _mm_sha1msg2_epu32(m0, m3);
+			abcd = _mm_sha1rnds4_epu32(abcd, e1, 3);
+			m2 = _mm_sha1msg1_epu32(m2, m3);
+			m1 = _mm_xor_si128(m1, m3);
+
+			// Rounds 64-67
+			e0 = _mm_sha1nexte_epu32(e0, m0);
+			e1 = abcd;
+			m1 = _mm_sha1msg2_epu32(m1, m0);
+			abcd = _mm_sha1rnds4_epu32(abcd, e0, 3);
+			m3 = _mm_sha1msg1_epu32(m3, m0);
+			m2 = _mm_xor_si128(m2, m0);
+
+			// Rounds 68-71
+			e1 = _mm_sha1nexte_epu32(e1, m1);
+			e0 = abcd;
+			m2 = _mm_sha1msg2_epu32(m2, m1);
+			abcd = _mm_sha1rnds4_epu32(abcd, e1, 3);
+			m3 = _mm_xor_si128(m3, m1);
+
+			// Rounds 72-75
+			e0 = _mm_sha1nexte_epu32(e0, m2);
+			e1 = abcd;
+			m3 = _mm_sha1msg2_epu32(m3, m2);
+			abcd = _mm_sha1rnds4_epu32(abcd, e0, 3);
+
+			// Rounds 76-79
+			e1 = _mm_sha1nexte_epu32(e1, m3);
+			e0 = abcd;
+			abcd = _mm_sha1rnds4_epu32(abcd, e1, 3);
+
+
+			e0 = _mm_sha1nexte_epu32(e0, e_save);
+			abcd = _mm_add_epi32(abcd, abcd_save);
+		}
+
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(H), _mm_shuffle_epi32(abcd, 0x1b));
+		H[4] = static_cast<uint32_t>(_mm_extract_epi32(e0, 3));
+	}
+
+	// Multi-buffer SHA-1: each vector element belongs to a different message.
+	// The state is stored as state[word * lanes + lane], so that one vector holds a word of all lanes.
+
+	template<int n>
+	DIGESTPP_TARGET("avx2")
+	inline __m256i rotl_avx2(__m256i x)
+	{
+		return _mm256_or_si256(_mm256_slli_epi32(x, n), _mm256_srli_epi32(x, 32 - n));
+	}
+
+	template<int f>
+	DIGESTPP_TARGET("avx2")
+	inline __m256i func_avx2(__m256i b, __m256i c, __m256i d)
+	{
+		if (f == 0)
+			return _mm256_xor_si256(d, _mm256_and_si256(b, _mm256_xor_si256(c, d)));
+		if (f == 2)
+			return _mm256_or_si256(_mm256_and_si256(b, c), _mm256_and_si256(d, _mm256_or_si256(b, c)));
+		return _mm256_xor_si256(_mm256_xor_si256(b, c), d);
+	}
+
+	template<int f>
+	DIGESTPP_TARGET("avx2")
+	inline void round_avx2(__m256i a, __m256i& b, __m256i c, __m256i d, __m256i& e, __m256i wk)
+	{
+		e = _mm256_add_epi32(_mm256_add_epi32(e, wk), _mm256_add_epi32(rotl_avx2<5>(a), func_avx2<f>(b, c, d)));
+		b = rotl_avx2<30>(b);
+	}
+
+	// 20 rounds with the round function and constant of group f
+	template<int f>
+	DIGESTPP_TARGET("avx2")
+	inline void rounds_avx2(__m256i* s, const __m256i* W)
+	{
+		const __m256i k = _mm256_set1_epi32(static_cast<int>(sha1_constants<void>::K[f]));
+		__m256i a = s[0], b = s[1], c = s[2], d = s[3], e = s[4];
+		for (int t = f * 20; t < f * 20 + 20; t += 5)
+		{
+			round_avx2<f>(a, b, c, d, e, _mm256_add_epi32(W[t], k));
+			round_avx2<f>(e, a, b, c, d, _mm256_add_epi32(W[t + 1], k));
+			round_avx2<f>(d, e, a, b, c, _mm256_add_epi32(W[t + 2], k));
+			round_avx2<f>(c, d, e, a, b, _mm256_add_epi32(W[t + 3], k));
+			round_avx2<f>(b, c, d, e, a, _mm256_add_epi32(W[t + 4], k));
+		}
+		s[0] = a;
+		s[1] = b;
+		s[2] = c;
+		s[3] = d;
+		s[4] = e;
+	}
+
+	// Compress one block in each of 8 lanes
+	DIGESTPP_TARGET("avx2")
+	inline void transform_x8_avx2(uint32_t* state, const unsigned char* const* blocks)
+	{
+		__m256i W[80];
+		multi_buffer::load_words_avx2<true>(blocks, 0, W);
+		multi_buffer::load_words_avx2<true>(blocks, 32, W + 8);
+		for (int t = 16; t < 80; t++)
+			W[t] = rotl_avx2<1>(_mm256_xor_si256(_mm256_xor_si256(W[t - 3], W[t - 8]), _mm256_xor_si256(W[t - 14], W[t - 16])));
+
+		__m256i S[5], R[5];
+		for (int i = 0; i < 5; i++)
+			R[i] = S[i] = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(state + i * 8));
+		rounds_avx2<0>(R, W);
+		rounds_avx2<1>(R, W);
+		rounds_avx2<2>(R, W);
+		rounds_avx2<3>(R, W);
+		for (int i = 0; i < 5; i++)
+			_mm256_storeu_si256(reinterpret_cast<__m256i*>(state + i * 8), _mm256_add_epi32(S[i], R[i]));
+	}
+
+	template<int f>
+	DIGESTPP_TARGET("avx512f,avx512bw,avx512vl")
+	inline void round_avx512(__m512i a, __m512i& b, __m512i c, __m512i d, __m512i& e, __m512i wk)
+	{
+		__m512i fn = _mm512_ternarylogic_epi32(b, c, d, f == 0 ? 0xca : f == 2 ? 0xe8 : 0x96);
+		e = _mm512_add_epi32(_mm512_add_epi32(e, wk), _mm512_add_epi32(_mm512_rol_epi32(a, 5), fn));
+		b = _mm512_rol_epi32(b, 30);
+	}
+
+	template<int f>
+	DIGESTPP_TARGET("avx512f,avx512bw,avx512vl")
+	inline void rounds_avx512(__m512i* s, const __m512i* W)
+	{
+		const __m512i k = _mm512_set1_epi32(static_cast<int>(sha1_constants<void>::K[f]));
+		__m512i a = s[0], b = s[1], c = s[2], d = s[3], e = s[4];
+		for (int t = f * 20; t < f * 20 + 20; t += 5)
+		{
+			round_avx512<f>(a, b, c, d, e, _mm512_add_epi32(W[t], k));
+			round_avx512<f>(e, a, b, c, d, _mm512_add_epi32(W[t + 1], k));
+			round_avx512<f>(d, e, a, b, c, _mm512_add_epi32(W[t + 2], k));
+			round_avx512<f>(c, d, e, a, b, _mm512_add_epi32(W[t + 3], k));
+			round_avx512<f>(b, c, d, e, a, _mm512_add_epi32(W[t + 4], k));
+		}
+		s[0] = a;
+		s[1] = b;
+		s[2] = c;
+		s[3] = d;
+		s[4] = e;
+	}
+
+	// Compress one block in each of 16 lanes
+	DIGESTPP_TARGET("avx512f,avx512bw,avx512vl")
+	inline void transform_x16_avx512(uint32_t* state, const unsigned char* const* blocks)
+	{
+		__m512i W[80];
+		multi_buffer::load_words_avx512<true>(blocks, W);
+		for (int t = 16; t < 80; t++)
+			W[t] = _mm512_rol_epi32(_mm512_ternarylogic_epi32(_mm512_xor_si512(W[t - 3], W[t - 8]), W[t - 14], W[t - 16], 0x96), 1);
+
+		__m512i S[5], R[5];
+		for (int i = 0; i < 5; i++)
+			R[i] = S[i] = _mm512_loadu_si512(state + i * 16);
+		rounds_avx512<0>(R, W);
+		rounds_avx512<1>(R, W);
+		rounds_avx512<2>(R, W);
+		rounds_avx512<3>(R, W);
+		for (int i = 0; i < 5; i++)
+			_mm512_storeu_si512(state + i * 16, _mm512_add_epi32(S[i], R[i]));
+	}
+#endif
+
+	// Process the blocks with the best kernel available on this CPU.
+	// Returns false if there is none, in which case the caller uses portable code.
+	inline bool transform(uint32_t* H, const unsigned char* data, size_t num_blks)
+	{
+#ifdef DIGESTPP_X86_SIMD
+		const cpu_features& cpu = cpu_features::get();
+		if (cpu.sha && cpu.sse41)
+		{
+			transform_shani(H, data, num_blks);
+			return true;
+		}
+#else
+		(void)H;
+		(void)data;
+		(void)num_blks;
+#endif
+		return false;
+	}
+
+	struct sha1_batch_traits
+	{
+		static const size_t words = 5;
+		static const size_t digest_size = 20;
+		static const bool big_endian = true;
+		static const uint32_t* iv()
+		{
+			static const uint32_t H[5] = { 0x67452301, 0xefcdab89, 0x98badcfe, 0x10325476, 0xc3d2e1f0 };
+			return H;
+		}
+	};
+
+	// Compute SHA-1 of count messages with the multi-buffer kernel for this CPU.
+	// Returns false if there is none, in which case the caller hashes the messages one by one.
+	inline bool hash_batch(const unsigned char* const* data, const size_t* len, size_t count, unsigned char* out)
+	{
+#ifdef DIGESTPP_X86_SIMD
+		const cpu_features& cpu = cpu_features::get();
+		if (cpu.avx512)
+		{
+			multi_buffer::hash<16, sha1_batch_traits>(data, len, count, out, transform_x16_avx512);
+			return true;
+		}
+		// On CPUs with SHA extensions, hashing the messages one by one is faster than 8 lanes
+		if (cpu.avx2 && !cpu.sha)
+		{
+			multi_buffer::hash<8, sha1_batch_traits>(data, len, count, out, transform_x8_avx2);
+			return true;
+		}
+#else
+		(void)data;
+		(void)len;
+		(void)count;
+		(void)out;
+#endif
+		return false;
+	}
+
+} // namespace sha1_simd
+
+} // namespace detail
+
+} // namespace digestpp
+
+#endif // DIGESTPP_PROVIDERS_SHA1_SIMD_HPP
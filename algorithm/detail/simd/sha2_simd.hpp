@@ -0,0 +1,437 @@
+/*
+This code is written by kerukuro and released into public domain.
+*/
+
+#ifndef DIGESTPP_PROVIDERS_SHA2_SIMD_HPP
+#define DIGESTPP_PROVIDERS_SHA2_SIMD_HPP
+
+#include "../../../detail/cpu_features.hpp"
+#include "../../../detail/functions.hpp"
+#include "../constants/sha2_constants.hpp"
+#include "../multi_buffer.hpp"
+#include <cstddef>
+#include <cstdint>
+
+namespace digestpp
+{
+
+namespace detail
+{
+
+namespace sha2_simd
+{
+
+#ifdef DIGESTPP_X86_SIMD
+	// SHA-256 compression using SHA extensions.
+	// The instructions keep the state as ABEF and CDGH, each sha256rnds2 performs two rounds,
+	// and sha256msg1/sha256msg2 compute the message schedule four words at a time.
+	DIGESTPP_TARGET("sha,sse4.1")
+	inline void transform_shani(uint32_t* H, const unsigned char* data, size_t num_blks)
+	{
+		const uint32_t* K = sha256_constants<void>::K;
+		const __m128i mask = _mm_set_epi64x(0x0c0d0e0f08090a0bull, 0x0405060700010203ull);
+
+		__m128i tmp = _mm_shuffle_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(H)), 0xb1); // CDAB
+		__m128i state1 = _mm_shuffle_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(H + 4)), 0x1b); // EFGH
+		__m128i state0 = _mm_alignr_epi8(tmp, state1, 8); // ABEF
+		state1 = _mm_blend_epi16(state1, tmp, 0xf0); // CDGH
+
+		for (size_t blk = 0; blk < num_blks; blk++, data += 64)
+		{
+			__m128i abef = state0;
+			__m128i cdgh = state1;
+			__m128i msg, m0, m1, m2, m3;
+
+			// Rounds 0-3
+			m0 = _mm_shuffle_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(data + 0)), mask);
+			msg = _mm_add_epi32(m0, _mm_loadu_si128(reinterpret_cast<const __m128i*>(K + 0)));
+			state1 = _mm_sha256rnds2_epu32(state1, state0, msg);
+			state0 = _mm_sha256rnds2_epu32(state0, state1, _mm_shuffle_epi32(msg, 0x0e));
+
+			// Rounds 4-7
+			m1 = _mm_shuffle_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(data + 16)), mask);
+			msg = _mm_add_epi32(m1, _mm_loadu_si128(reinterpret_cast<const __m128i*>(K + 4)));
+			state1 = _mm_sha256rnds2_epu32(state1, state0, msg);
+			state0 = _mm_sha256rnds2_epu32(state0, state1, _mm_shuffle_epi32(msg, 0x0e));
+			m0 = _mm_sha256msg1_epu32(m0, m1);
+
+			// Rounds 8-11
+			m2 = _mm_shuffle_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(data + 32)), mask);
+			msg = _mm_add_epi32(m2, _mm_loadu_si128(reinterpret_cast<const __m128i*>(K + 8)));
+			state1 = _mm_sha256rnds2_epu32(state1, state0, msg);
+			state0 = _mm_sha256rnds2_epu32(state0, state1, _mm_shuffle_epi32(msg, 0x0e));
+			m1 = _mm_sha256msg1_epu32(m1, m2);
+
+			// Rounds 12-15
+			m3 = _mm_shuffle_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(data + 48)), mask);
+			msg = _mm_add_epi32(m3, _mm_loadu_si128(reinterpret_cast<const __m128i*>(K + 12)));
+			state1 = _mm_sha256rnds2_epu32(state1, state0, msg);
+			m0 = _mm_sha256msg2_epu32(_mm_add_epi32(m0, _mm_alignr_epi8(m3, m2, 4)), m3);
+			state0 = _mm_sha256rnds2_epu32(state0, state1, _mm_shuffle_epi32(msg, 0x0e));
+			m2 = _mm_sha256msg1_epu32(m2, m3);
+
+			// Rounds 16-19
+			msg = _mm_add_epi32(m0, _mm_loadu_si128(reinterpret_cast<const __m128i*>(K + 16)));
+			state1 = _mm_sha256rnds2_epu32(state1, state0, msg);
+			m1 = _mm_sha256msg2_epu32(_mm_add_epi32(m1, _mm_alignr_epi8(m0, m3, 4)), m0);
+			state0 = _mm_sha256rnds2_epu32(state0, state1, _mm_shuffle_epi32(msg, 0x0e));
+			m3 = _mm_sha256msg1_epu32(m3, m0);
+
+			// Rounds 20-23
+			msg = _mm_add_epi32(m1, _mm_loadu_si128(reinterpret_cast<const __m128i*>(K + 20)));
+			state1 = _mm_sha256rnds2_epu32(state1, state0, msg);
+			m2 = _mm_sha256msg2_epu32(_mm_add_epi32(m2, _mm_alignr_epi8(m1, m0, 4)), m1);
+			state0 = _mm_sha256rnds2_epu32(state0, state1, _mm_shuffle_epi32(msg, 0x0e));
+			m0 = _mm_sha256msg1_epu32(m0, m1);
+
+			// Rounds 24-27
+			msg = _mm_add_epi32(m2, _mm_loadu_si128(reinterpret_cast<const __m128i*>(K + 24)));
+			state1 = _mm_sha256rnds2_epu32(state1, state0, msg);
+			m3 = _mm_sha256msg2_epu32(_mm_add_epi32(m3, _mm_alignr_epi8(m2, m1, 4)), m2);
+			state0 = _mm_sha256rnds2_epu32(state0, state1, _mm_shuffle_epi32(msg, 0x0e));
+			m1 = _mm_sha256msg1_epu32(m1, m2);
+
+			// Rounds 28-31
+			msg = _mm_add_epi32(m3, _mm_loadu_si128(reinterpret_cast<const __m128i*>(K + 28)));
+			state1 = _mm_sha256rnds2_epu32(state1, state0, msg);
+			m0 = _mm_sha256msg2_epu32(_mm_add_epi32(m0, _mm_alignr_epi8(m3, m2, 4)), m3);
+			state0 = _mm_sha256rnds2_epu32(state0, state1, _mm_shuffle_epi32(msg, 0x0e));
+			m2 = _mm_sha256msg1_epu32(m2, m3);
+
+			// Rounds 32-35
+			msg = _mm_add_epi32(m0, _mm_loadu_si128(reinterpret_cast<const __m128i*>(K + 32)));
+			state1 = _mm_sha256rnds2_epu32(state1, state0, msg);
+			m1 = _mm_sha256msg2_epu32(_mm_add_epi32(m1, _mm_alignr_epi8(m0, m3, 4)), m0);
+			state0 = _mm_sha256rnds2_epu32(state0, state1, _mm_shuffle_epi32(msg, 0x0e));
+			m3 = _mm_sha256msg1_epu32(m3, m0);
+
+			// Rounds 36-39
+			msg = _mm_add_epi32(m1, _mm_loadu_si128(reinterpret_cast<const __m128i*>(K + 36)));
+			state1 = _mm_sha256rnds2_epu32(state1, state0, msg);
+			m2 = _mm_sha256msg2_epu32(_mm_add_epi32(m2, _mm_alignr_epi8(m1, m0, 4)), m1);
+			state0 = _mm_sha256rnds2_epu32(state0, state1, _mm_shuffle_epi32(msg, 0x0e));
+			m0 = _mm_sha256msg1_epu32(m0, m1);
+
+			// Rounds 40-43
+			msg = _mm_add_epi32(m2, _mm_loadu_si128(reinterpret_cast<const __m128i*>(K + 40)));
+			state1 = _mm_sha256rnds2_epu32(state1, state0, msg);
+			m3 = _mm_sha256msg2_epu32(_mm_add_epi32(m3, _mm_alignr_epi8(m2, m1, 4)), m2);
+			state0 = _mm_sha256rnds2_epu32(state0, state1, _mm_shuffle_epi32(msg, 0x0e));
+			m1 = _mm_sha256msg1_epu32(m1, m2);
+
+			// Rounds 44-47
+			msg = _mm_add_epi32(m3, _mm_loadu_si128(reinterpret_cast<const __m128i*>(K + 44)));
+			state1 = _mm_sha256rnds2_epu32(state1, state0, msg);
+			m0 = _mm_sha256msg2_epu32(_mm_add_epi32(m0, _mm_alignr_epi8(m3, m2, 4)), m3);
+			state0 = _mm_sha256rnds2_epu32(state0, state1, _mm_shuffle_epi32(msg, 0x0e));
+			m2 = _mm_sha256msg1_epu32(m2, m3);
+
+			// Rounds 48-51
+			msg = _mm_add_epi32(m0, _mm_loadu_si128(reinterpret_cast<const __m128i*>(K + 48)));
+			state1 = _mm_sha256rnds2_epu32(state1, state0, msg);
+			m1 = _mm_sha256msg2_epu32(_mm_add_epi32(m1, _mm_alignr_epi8(m0, m3, 4)), m0);
+			state0 = _mm_sha256rnds2_epu32(state0, state1, _mm_shuffle_epi32(msg, 0x0e));
+			m3 = _mm_sha256msg1_epu32(m3, m0);
+
+			// Rounds 52-55
+			msg = _mm_add_epi32(m1, _mm_loadu_si128(reinterpret_cast<const __m128i*>(K + 52)));
+			state1 = _mm_sha256rnds2_epu32(state1, state0, msg);
+			m2 = _mm_sha256msg2_epu32(_mm_add_epi32(m2, _mm_alignr_epi8(m1, m0, 4)), m1);
+			state0 = _mm_sha256rnds2_epu32(state0, state1, _mm_shuffle_epi32(msg, 0x0e));
+
+			// Rounds 56-59
+			msg = _mm_add_epi32(m2, _mm_loadu_si128(reinterpret_cast<const __m128i*>(K + 56)));
+			state1 = _mm_sha256rnds2_epu32(state1, state0, msg);
+			m3 = _mm_sha256msg2_epu32(_mm_add_epi32(m3, _mm_alignr_epi8(m2, m1, 4)), m2);
+			state0 = _mm_sha256rnds2_epu32(state0, state1, _mm_shuffle_epi32(msg, 0x0e));
+
+			// Rounds 60-63
+			msg = _mm_add_epi32(m3, _mm_loadu_si128(reinterpret_cast<const __m128i*>(K + 60)));
+			state1 = _mm_sha256rnds2_epu32(state1, state0, msg);
+			state0 = _mm_sha256rnds2_epu32(state0, state1, _mm_shuffle_epi32(msg, 0x0e));
+
+			state0 = _mm_add_epi32(state0, abef);
+			state1 = _mm_add_epi32(state1, cdgh);
+		}
+
+		tmp = _mm_shuffle_epi32(state0, 0x1b); // FEBA
+		state1 = _mm_shuffle_epi32(state1, 0xb1); // DCHG
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(H), _mm_blend_epi16(tmp, state1, 0xf0)); // DCBA
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(H + 4), _mm_alignr_epi8(state1, tmp, 8)); // HGFE
+	}
+
+	// Multi-buffer SHA-256: each vector element belongs to a different message.
+	// The state is stored as state[word * lanes + lane], so that one vector holds a word of all lanes.
+
+	template<int n>
+	DIGESTPP_TARGET("avx2")
+	inline __m256i rotr_avx2(__m256i x)
+	{
+		return _mm256_or_si256(_mm256_srli_epi32(x, n), _mm256_slli_epi32(x, 32 - n));
+	}
+
+	DIGESTPP_TARGET("avx2")
+	inline void round_avx2(__m256i a, __m256i b, __m256i c, __m256i& d, __m256i e, __m256i f, __m256i g, __m256i& h,
+			uint32_t k, __m256i w)
+	{
+		__m256i sum1 = _mm256_xor_si256(_mm256_xor_si256(rotr_avx2<6>(e), rotr_avx2<11>(e)), rotr_avx2<25>(e));
+		__m256i ch = _mm256_xor_si256(_mm256_and_si256(e, f), _mm256_andnot_si256(e, g));
+		__m256i t1 = _mm256_add_epi32(_mm256_add_epi32(_mm256_add_epi32(h, sum1), _mm256_add_epi32(ch, w)), _mm256_set1_epi32(static_cast<int>(k)));
+		__m256i sum0 = _mm256_xor_si256(_mm256_xor_si256(rotr_avx2<2>(a), rotr_avx2<13>(a)), rotr_avx2<22>(a));
+		__m256i maj = _mm256_xor_si256(_mm256_and_si256(a, b), _mm256_and_si256(c, _mm256_xor_si256(a, b)));
+		d = _mm256_add_epi32(d, t1);
+		h = _mm256_add_epi32(t1, _mm256_add_epi32(sum0, maj));
+	}
+
+	// Compress one block in each of 8 lanes
+	DIGESTPP_TARGET("avx2")
+	inline void transform_x8_avx2(uint32_t* state, const unsigned char* const* blocks)
+	{
+		const uint32_t* K = sha256_constants<void>::K;
+		__m256i W[64];
+		multi_buffer::load_words_avx2<true>(blocks, 0, W);
+		multi_buffer::load_words_avx2<true>(blocks, 32, W + 8);
+		for (int t = 16; t < 64; t++)
+		{
+			__m256i s0 = _mm256_xor_si256(_mm256_xor_si256(rotr_avx2<7>(W[t - 15]), rotr_avx2<18>(W[t - 15])), _mm256_srli_epi32(W[t - 15], 3));
+			__m256i s1 = _mm256_xor_si256(_mm256_xor_si256(rotr_avx2<17>(W[t - 2]), rotr_avx2<19>(W[t - 2])), _mm256_srli_epi32(W[t - 2], 10));
+			W[t] = _mm256_add_epi32(_mm256_add_epi32(s1, W[t - 7]), _mm256_add_epi32(s0, W[t - 16]));
+		}
+
+		__m256i S[8];
+		for (int i = 0; i < 8; i++)
+			S[i] = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(state + i * 8));
+		__m256i a = S[0], b = S[1], c = S[2], d = S[3], e = S[4], f = S[5], g = S[6], h = S[7];
+		for (int t = 0; t < 64; t += 8)
+		{
+			round_avx2(a, b, c, d, e, f, g, h, K[t], W[t]);
+			round_avx2(h, a, b, c, d, e, f, g, K[t + 1], W[t + 1]);
+			round_avx2(g, h, a, b, c, d, e, f, K[t + 2], W[t + 2]);
+			round_avx2(f, g, h, a, b, c, d, e, K[t + 3], W[t + 3]);
+			round_avx2(e, f, g, h, a, b, c, d, K[t + 4], W[t + 4]);
+			round_avx2(d, e, f, g, h, a, b, c, K[t + 5], W[t + 5]);
+			round_avx2(c, d, e, f, g, h, a, b, K[t + 6], W[t + 6]);
+			round_avx2(b, c, d, e, f, g, h, a, K[t + 7], W[t + 7]);
+		}
+		__m256i R[8] = { a, b, c, d, e, f, g, h };
+		for (int i = 0; i < 8; i++)
+			_mm256_storeu_si256(reinterpret_cast<__m256i*>(state + i * 8), _mm256_add_epi32(S[i], R[i]));
+	}
+
+	DIGESTPP_TARGET("avx512f,avx512bw,avx512vl")
+	inline void round_avx512(__m512i a, __m512i b, __m512i c, __m512i& d, __m512i e, __m512i f, __m512i g, __m512i& h,
+			uint32_t k, __m512i w)
+	{
+		__m512i sum1 = _mm512_ternarylogic_epi32(_mm512_ror_epi32(e, 6), _mm512_ror_epi32(e, 11), _mm512_ror_epi32(e, 25), 0x96);
+		__m512i ch = _mm512_ternarylogic_epi32(e, f, g, 0xca);
+		__m512i t1 = _mm512_add_epi32(_mm512_add_epi32(_mm512_add_epi32(h, sum1), _mm512_add_epi32(ch, w)), _mm512_set1_epi32(static_cast<int>(k)));
+		__m512i sum0 = _mm512_ternarylogic_epi32(_mm512_ror_epi32(a, 2), _mm512_ror_epi32(a, 13), _mm512_ror_epi32(a, 22), 0x96);
+		__m512i maj = _mm512_ternarylogic_epi32(a, b, c, 0xe8);
+		d = _mm512_add_epi32(d, t1);
+		h = _mm512_add_epi32(t1, _mm512_add_epi32(sum0, maj));
+	}
+
+	// Compress one block in each of 16 lanes
+	DIGESTPP_TARGET("avx512f,avx512bw,avx512vl")
+	inline void transform_x16_avx512(uint32_t* state, const unsigned char* const* blocks)
+	{
+		const uint32_t* K = sha256_constants<void>::K;
+		__m512i W[64];
+		multi_buffer::load_words_avx512<true>(blocks, W);
+		for (int t = 16; t < 64; t++)
+		{
+			__m512i s0 = _mm512_ternarylogic_epi32(_mm512_ror_epi32(W[t - 15], 7), _mm512_ror_epi32(W[t - 15], 18), _mm512_srli_epi32(W[t - 15], 3), 0x96);
+			__m512i s1 = _mm512_ternarylogic_epi32(_mm512_ror_epi32(W[t - 2], 17), _mm512_ror_epi32(W[t - 2], 19), _mm512_srli_epi32(W[t - 2], 10), 0x96);
+			W[t] = _mm512_add_epi32(_mm512_add_epi32(s1, W[t - 7]), _mm512_add_epi32(s0, W[t - 16]));
+		}
+
+		__m512i S[8];
+		for (int i = 0; i < 8; i++)
+			S[i] = _mm512_loadu_si512(state + i * 16);
+		__m512i a = S[0], b = S[1], c = S[2], d = S[3], e = S[4], f = S[5], g = S[6], h = S[7];
+		for (int t = 0; t < 64; t += 8)
+		{
+			round_avx512(a, b, c, d, e, f, g, h, K[t], W[t]);
+			round_avx512(h, a, b, c, d, e, f, g, K[t + 1], W[t + 1]);
+			round_avx512(g, h, a, b, c, d, e, f, K[t + 2], W[t + 2]);
+			round_avx512(f, g, h, a, b, c, d, e, K[t + 3], W[t + 3]);
+			round_avx512(e, f, g, h, a, b, c, d, K[t + 4], W[t + 4]);
+			round_avx512(d, e, f, g, h, a, b, c, K[t + 5], W[t + 5]);
+			round_avx512(c, d, e, f, g, h, a, b, K[t + 6], W[t + 6]);
+			round_avx512(b, c, d, e, f, g, h, a, K[t + 7], W[t + 7]);
+		}
+		__m512i R[8] = { a, b, c, d, e, f, g, h };
+		for (int i = 0; i < 8; i++)
+			_mm512_storeu_si512(state + i * 16, _mm512_add_epi32(S[i], R[i]));
+	}
+
+	// SHA-512 message schedule with AVX2 and rounds with scalar code.
+	// The schedule is computed four words at a time: s1() depends on the words two positions back,
+	// so the lower two words are computed first and then used for the upper two.
+	// K[t] is added during the expansion, so that the rounds only need one load.
+
+	template<int n>
+	DIGESTPP_TARGET("avx2")
+	inline __m256i rotr64_avx2(__m256i x)
+	{
+		return _mm256_or_si256(_mm256_srli_epi64(x, n), _mm256_slli_epi64(x, 64 - n));
+	}
+
+	// Words 1-4 of the concatenation of a and b
+	DIGESTPP_TARGET("avx2")
+	inline __m256i next_words_avx2(__m256i a, __m256i b)
+	{
+		return _mm256_alignr_epi8(_mm256_permute2x128_si256(a, b, 0x21), a, 8);
+	}
+
+	DIGESTPP_TARGET("avx2")
+	inline __m256i sigma1_avx2(__m256i x)
+	{
+		return _mm256_xor_si256(_mm256_xor_si256(rotr64_avx2<19>(x), rotr64_avx2<61>(x)), _mm256_srli_epi64(x, 6));
+	}
+
+	DIGESTPP_TARGET("bmi2")
+	inline void round_bmi2(uint64_t a, uint64_t b, uint64_t& d, uint64_t e, uint64_t f, uint64_t g, uint64_t& h, uint64_t wk, uint64_t& bc)
+	{
+		uint64_t T1 = h + (rotate_right(e, 14) ^ rotate_right(e, 18) ^ rotate_right(e, 41)) + (g ^ (e & (f ^ g))) + wk;
+		uint64_t ab = a ^ b;
+		d += T1;
+		h = T1 + (rotate_right(a, 28) ^ rotate_right(a, 34) ^ rotate_right(a, 39)) + (b ^ (ab & bc));
+		bc = ab;
+	}
+
+	DIGESTPP_TARGET("avx2,bmi2")
+	inline void transform_avx2(uint64_t* H, const unsigned char* data, size_t num_blks)
+	{
+		const uint64_t* K = sha512_constants<void>::K;
+		const __m256i bswap = _mm256_set_epi64x(0x08090a0b0c0d0e0full, 0x0001020304050607ull,
+				0x08090a0b0c0d0e0full, 0x0001020304050607ull);
+
+		for (size_t blk = 0; blk < num_blks; blk++, data += 128)
+		{
+			__m256i W[20];
+			uint64_t WK[80];
+			for (int i = 0; i < 4; i++)
+			{
+				W[i] = _mm256_shuffle_epi8(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i * 32)), bswap);
+				_mm256_storeu_si256(reinterpret_cast<__m256i*>(WK + i * 4),
+						_mm256_add_epi64(W[i], _mm256_loadu_si256(reinterpret_cast<const __m256i*>(K + i * 4))));
+			}
+			for (int i = 4; i < 20; i++)
+			{
+				__m256i w15 = next_words_avx2(W[i - 4], W[i - 3]);
+				__m256i s0 = _mm256_xor_si256(_mm256_xor_si256(rotr64_avx2<1>(w15), rotr64_avx2<8>(w15)), _mm256_srli_epi64(w15, 7));
+				__m256i v = _mm256_add_epi64(_mm256_add_epi64(W[i - 4], s0), next_words_avx2(W[i - 2], W[i - 1]));
+				__m256i lo = _mm256_add_epi64(v, sigma1_avx2(_mm256_permute2x128_si256(W[i - 1], W[i - 1], 0x11)));
+				__m256i hi = _mm256_add_epi64(v, sigma1_avx2(_mm256_permute2x128_si256(lo, lo, 0x00)));
+				W[i] = _mm256_blend_epi32(lo, hi, 0xf0);
+				_mm256_storeu_si256(reinterpret_cast<__m256i*>(WK + i * 4),
+						_mm256_add_epi64(W[i], _mm256_loadu_si256(reinterpret_cast<const __m256i*>(K + i * 4))));
+			}
+
+			uint64_t a = H[0], b = H[1], c = H[2], d = H[3], e = H[4], f = H[5], g = H[6], h = H[7];
+			uint64_t bc = b ^ c;
+			for (int t = 0; t < 80; t += 8)
+			{
+				round_bmi2(a, b, d, e, f, g, h, WK[t], bc);
+				round_bmi2(h, a, c, d, e, f, g, WK[t + 1], bc);
+				round_bmi2(g, h, b, c, d, e, f, WK[t + 2], bc);
+				round_bmi2(f, g, a, b, c, d, e, WK[t + 3], bc);
+				round_bmi2(e, f, h, a, b, c, d, WK[t + 4], bc);
+				round_bmi2(d, e, g, h, a, b, c, WK[t + 5], bc);
+				round_bmi2(c, d, f, g, h, a, b, WK[t + 6], bc);
+				round_bmi2(b, c, e, f, g, h, a, WK[t + 7], bc);
+			}
+			H[0] += a;
+			H[1] += b;
+			H[2] += c;
+			H[3] += d;
+			H[4] += e;
+			H[5] += f;
+			H[6] += g;
+			H[7] += h;
+		}
+	}
+#endif
+
+	// Process the blocks with the best kernel available on this CPU.
+	// Returns false if there is none, in which case the caller uses portable code.
+	inline bool transform(uint32_t* H, const unsigned char* data, size_t num_blks)
+	{
+#ifdef DIGESTPP_X86_SIMD
+		const cpu_features& cpu = cpu_features::get();
+		if (cpu.sha && cpu.sse41)
+		{
+			transform_shani(H, data, num_blks);
+			return true;
+		}
+#else
+		(void)H;
+		(void)data;
+		(void)num_blks;
+#endif
+		return false;
+	}
+
+	inline bool transform(uint64_t* H, const unsigned char* data, size_t num_blks)
+	{
+#ifdef DIGESTPP_X86_SIMD
+		const cpu_features& cpu = cpu_features::get();
+		if (cpu.avx2 && cpu.bmi2)
+		{
+			transform_avx2(H, data, num_blks);
+			return true;
+		}
+#else
+		(void)H;
+		(void)data;
+		(void)num_blks;
+#endif
+		return false;
+	}
+
+	struct sha256_batch_traits
+	{
+		static const size_t words = 8;
+		static const size_t digest_size = 32;
+		static const bool big_endian = true;
+		static const uint32_t* iv()
+		{
+			static const uint32_t H[8] = { 0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a,
+					0x510e527f, 0x9b05688c, 0x1f83d9ab, 0x5be0cd19 };
+			return H;
+		}
+	};
+
+	// Compute SHA-256 of count messages with the multi-buffer kernel for this CPU.
+	// Returns false if there is none, in which case the caller hashes the messages one by one.
+	inline bool hash_batch(const unsigned char* const* data, const size_t* len, size_t count, unsigned char* out)
+	{
+#ifdef DIGESTPP_X86_SIMD
+		const cpu_features& cpu = cpu_features::get();
+		if (cpu.avx512)
+		{
+			multi_buffer::hash<16, sha256_batch_traits>(data, len, count, out, transform_x16_avx512);
+			return true;
+		}
+		// On CPUs with SHA extensions, hashing the messages one by one is faster than 8 lanes
+		if (cpu.avx2 && !cpu.sha)
+		{
+			multi_buffer::hash<8, sha256_batch_traits>(data, len, count, out, transform_x8_avx2);
+			return true;
+		}
+#else
+		(void)data;
+		(void)len;
+		(void)count;
+		(void)out;
+#endif
+		return false;
+	}
+}
+
+} // namespace detail
+
+} // namespace digestpp
+
+#endif
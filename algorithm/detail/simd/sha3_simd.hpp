@@ -0,0 +1,434 @@
+/*
+This code is written by kerukuro and released into public domain.
+*/
+
+#ifndef DIGESTPP_PROVIDERS_SHA3_SIMD_HPP
+#define DIGESTPP_PROVIDERS_SHA3_SIMD_HPP
+
+#include "../../../detail/cpu_features.hpp"
+#include "../../../detail/functions.hpp"
+#include "../sha3_provider.hpp"
+#include <algorithm>
+#include <cstring>
+#include <vector>
+
+namespace digestpp
+{
+
+namespace detail
+{
+
+namespace sha3_simd
+{
+	// Multi-lane Keccak-p[1600, R]: several independent states are permuted at once, one per vector element.
+	// States are stored as S[word * lanes + lane].
+	// absorb_*() XORs num_blks blocks of rate_words words into each state, permuting after each block;
+	// block i of lane l starts at data[l] + i * rate_words * 8. With rate_words = 0 the states are only permuted.
+
+	inline uint64_t load64(const unsigned char* p)
+	{
+		uint64_t v;
+		memcpy(&v, p, sizeof(v));
+		return v;
+	}
+
+	template<int R>
+	inline void absorb_x1(uint64_t* S, const unsigned char* const* data, size_t num_blks, size_t rate_words)
+	{
+		for (size_t blk = 0; blk < num_blks; blk++)
+		{
+			for (size_t i = 0; i < rate_words; i++)
+				S[i] ^= load64(data[0] + (blk * rate_words + i) * 8);
+			sha3_functions::transform<R>(S);
+		}
+	}
+
+#ifdef DIGESTPP_X86_SIMD
+	template<int n>
+	DIGESTPP_TARGET("avx2")
+	inline __m256i rotl64_avx2(__m256i x)
+	{
+		return _mm256_or_si256(_mm256_slli_epi64(x, n), _mm256_srli_epi64(x, 64 - n));
+	}
+
+	template<int R>
+	DIGESTPP_TARGET("avx2")
+	inline void absorb_x4_avx2(uint64_t* S, const unsigned char* const* data, size_t num_blks, size_t rate_words)
+	{
+		__m256i A[25];
+		for (int i = 0; i < 25; i++)
+			A[i] = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(S + i * 4));
+
+		for (size_t blk = 0; blk < num_blks; blk++)
+		{
+			for (size_t i = 0; i < rate_words; i++)
+			{
+				size_t offset = (blk * rate_words + i) * 8;
+				A[i] = _mm256_xor_si256(A[i], _mm256_set_epi64x(static_cast<long long>(load64(data[3] + offset)),
+						static_cast<long long>(load64(data[2] + offset)), static_cast<long long>(load64(data[1] + offset)),
+						static_cast<long long>(load64(data[0] + offset))));
+			}
+
+			for (int round = 24 - R; round < 24; round++)
+			{
+				__m256i C[5], D[5];
+				C[0] = _mm256_xor_si256(_mm256_xor_si256(_mm256_xor_si256(A[0 * 5 + 0], A[1 * 5 + 0]), _mm256_xor_si256(A[2 * 5 + 0], A[3 * 5 + 0])), A[4 * 5 + 0]);
+				C[1] = _mm256_xor_si256(_mm256_xor_si256(_mm256_xor_si256(A[0 * 5 + 1], A[1 * 5 + 1]), _mm256_xor_si256(A[2 * 5 + 1], A[3 * 5 + 1])), A[4 * 5 + 1]);
+				C[2] = _mm256_xor_si256(_mm256_xor_si256(_mm256_xor_si256(A[0 * 5 + 2], A[1 * 5 + 2]), _mm256_xor_si256(A[2 * 5 + 2], A[3 * 5 + 2])), A[4 * 5 + 2]);
+				C[3] = _mm256_xor_si256(_mm256_xor_si256(_mm256_xor_si256(A[0 * 5 + 3], A[1 * 5 + 3]), _mm256_xor_si256(A[2 * 5 + 3], A[3 * 5 + 3])), A[4 * 5 + 3]);
+				C[4] = _mm256_xor_si256(_mm256_xor_si256(_mm256_xor_si256(A[0 * 5 + 4], A[1 * 5 + 4]), _mm256_xor_si256(A[2 * 5 + 4], A[3 * 5 + 4])), A[4 * 5 + 4]);
+
+				D[0] = _mm256_xor_si256(C[4], rotl64_avx2<1>(C[1]));
+				D[1] = _mm256_xor_si256(C[0], rotl64_avx2<1>(C[2]));
+				D[2] = _mm256_xor_si256(C[1], rotl64_avx2<1>(C[3]));
+				D[3] = _mm256_xor_si256(C[2], rotl64_avx2<1>(C[4]));
+				D[4] = _mm256_xor_si256(C[3], rotl64_avx2<1>(C[0]));
+
+				__m256i B00 = _mm256_xor_si256(A[0 * 5 + 0], D[0]);
+				__m256i B10 = rotl64_avx2<1>(_mm256_xor_si256(A[0 * 5 + 1], D[1]));
+				__m256i B20 = rotl64_avx2<62>(_mm256_xor_si256(A[0 * 5 + 2], D[2]));
+				__m256i B5 = rotl64_avx2<28>(_mm256_xor_si256(A[0 * 5 + 3], D[3]));
+				__m256i B15 = rotl64_avx2<27>(_mm256_xor_si256(A[0 * 5 + 4], D[4]));
+
+				__m256i B16 = rotl64_avx2<36>(_mm256_xor_si256(A[1 * 5 + 0], D[0]));
+				__m256i B1 = rotl64_avx2<44>(_mm256_xor_si256(A[1 * 5 + 1], D[1]));
+				__m256i B11 = rotl64_avx2<6>(_mm256_xor_si256(A[1 * 5 + 2], D[2]));
+				__m256i B21 = rotl64_avx2<55>(_mm256_xor_si256(A[1 * 5 + 3], D[3]));
+				__m256i B6 = rotl64_avx2<20>(_mm256_xor_si256(A[1 * 5 + 4], D[4]));
+
+				__m256i B7 = rotl64_avx2<3>(_mm256_xor_si256(A[2 * 5 + 0], D[0]));
+				__m256i B17 = rotl64_avx2<10>(_mm256_xor_si256(A[2 * 5 + 1], D[1]));
+				__m256i B2 = rotl64_avx2<43>(_mm256_xor_si256(A[2 * 5 + 2], D[2]));
+				__m256i B12 = rotl64_avx2<25>(_mm256_xor_si256(A[2 * 5 + 3], D[3]));
+				__m256i B22 = rotl64_avx2<39>(_mm256_xor_si256(A[2 * 5 + 4], D[4]));
+
+				__m256i B23 = rotl64_avx2<41>(_mm256_xor_si256(A[3 * 5 + 0], D[0]));
+				__m256i B8 = rotl64_avx2<45>(_mm256_xor_si256(A[3 * 5 + 1], D[1]));
+				__m256i B18 = rotl64_avx2<15>(_mm256_xor_si256(A[3 * 5 + 2], D[2]));
+				__m256i B3 = rotl64_avx2<21>(_mm256_xor_si256(A[3 * 5 + 3], D[3]));
+				__m256i B13 = rotl64_avx2<8>(_mm256_xor_si256(A[3 * 5 + 4], D[4]));
+
+				__m256i B14 = rotl64_avx2<18>(_mm256_xor_si256(A[4 * 5 + 0], D[0]));
+				__m256i B24 = rotl64_avx2<2>(_mm256_xor_si256(A[4 * 5 + 1], D[1]));
+				__m256i B9 = rotl64_avx2<61>(_mm256_xor_si256(A[4 * 5 + 2], D[2]));
+				__m256i B19 = rotl64_avx2<56>(_mm256_xor_si256(A[4 * 5 + 3], D[3]));
+				__m256i B4 = rotl64_avx2<14>(_mm256_xor_si256(A[4 * 5 + 4], D[4]));
+
+				A[0 * 5 + 0] = _mm256_xor_si256(B00, _mm256_andnot_si256(B1, B2));
+				A[0 * 5 + 1] = _mm256_xor_si256(B1, _mm256_andnot_si256(B2, B3));
+				A[0 * 5 + 2] = _mm256_xor_si256(B2, _mm256_andnot_si256(B3, B4));
+				A[0 * 5 + 3] = _mm256_xor_si256(B3, _mm256_andnot_si256(B4, B00));
+				A[0 * 5 + 4] = _mm256_xor_si256(B4, _mm256_andnot_si256(B00, B1));
+
+				A[1 * 5 + 0] = _mm256_xor_si256(B5, _mm256_andnot_si256(B6, B7));
+				A[1 * 5 + 1] = _mm256_xor_si256(B6, _mm256_andnot_si256(B7, B8));
+				A[1 * 5 + 2] = _mm256_xor_si256(B7, _mm256_andnot_si256(B8, B9));
+				A[1 * 5 + 3] = _mm256_xor_si256(B8, _mm256_andnot_si256(B9, B5));
+				A[1 * 5 + 4] = _mm256_xor_si256(B9, _mm256_andnot_si256(B5, B6));
+
+				A[2 * 5 + 0] = _mm256_xor_si256(B10, _mm256_andnot_si256(B11, B12));
+				A[2 * 5 + 1] = _mm256_xor_si256(B11, _mm256_andnot_si256(B12, B13));
+				A[2 * 5 + 2] = _mm256_xor_si256(B12, _mm256_andnot_si256(B13, B14));
+				A[2 * 5 + 3] = _mm256_xor_si256(B13, _mm256_andnot_si256(B14, B10));
+				A[2 * 5 + 4] = _mm256_xor_si256(B14, _mm256_andnot_si256(B10, B11));
+
+				A[3 * 5 + 0] = _mm256_xor_si256(B15, _mm256_andnot_si256(B16, B17));
+				A[3 * 5 + 1] = _mm256_xor_si256(B16, _mm256_andnot_si256(B17, B18));
+				A[3 * 5 + 2] = _mm256_xor_si256(B17, _mm256_andnot_si256(B18, B19));
+				A[3 * 5 + 3] = _mm256_xor_si256(B18, _mm256_andnot_si256(B19, B15));
+				A[3 * 5 + 4] = _mm256_xor_si256(B19, _mm256_andnot_si256(B15, B16));
+
+				A[4 * 5 + 0] = _mm256_xor_si256(B20, _mm256_andnot_si256(B21, B22));
+				A[4 * 5 + 1] = _mm256_xor_si256(B21, _mm256_andnot_si256(B22, B23));
+				A[4 * 5 + 2] = _mm256_xor_si256(B22, _mm256_andnot_si256(B23, B24));
+				A[4 * 5 + 3] = _mm256_xor_si256(B23, _mm256_andnot_si256(B24, B20));
+				A[4 * 5 + 4] = _mm256_xor_si256(B24, _mm256_andnot_si256(B20, B21));
+
+				A[0] = _mm256_xor_si256(A[0], _mm256_set1_epi64x(static_cast<long long>(sha3_constants<void>::RC[round])));
+			}
+		}
+
+		for (int i = 0; i < 25; i++)
+			_mm256_storeu_si256(reinterpret_cast<__m256i*>(S + i * 4), A[i]);
+	}
+
+	template<int R>
+	DIGESTPP_TARGET("avx512f,avx512bw,avx512vl")
+	inline void absorb_x8_avx512(uint64_t* S, const unsigned char* const* data, size_t num_blks, size_t rate_words)
+	{
+		__m512i A[25];
+		for (int i = 0; i < 25; i++)
+			A[i] = _mm512_loadu_si512(S + i * 8);
+
+		for (size_t blk = 0; blk < num_blks; blk++)
+		{
+			for (size_t i = 0; i < rate_words; i++)
+			{
+				size_t offset = (blk * rate_words + i) * 8;
+				__m256i lo = _mm256_set_epi64x(static_cast<long long>(load64(data[3] + offset)),
+						static_cast<long long>(load64(data[2] + offset)), static_cast<long long>(load64(data[1] + offset)),
+						static_cast<long long>(load64(data[0] + offset)));
+				__m256i hi = _mm256_set_epi64x(static_cast<long long>(load64(data[7] + offset)),
+						static_cast<long long>(load64(data[6] + offset)), static_cast<long long>(load64(data[5] + offset)),
+						static_cast<long long>(load64(data[4] + offset)));
+				A[i] = _mm512_xor_si512(A[i], _mm512_inserti64x4(_mm512_castsi256_si512(lo), hi, 1));
+			}
+
+			for (int round = 24 - R; round < 24; round++)
+			{
+				__m512i C[5], D[5];
+				C[0] = _mm512_ternarylogic_epi64(_mm512_ternarylogic_epi64(A[0 * 5 + 0], A[1 * 5 + 0], A[2 * 5 + 0], 0x96), A[3 * 5 + 0], A[4 * 5 + 0], 0x96);
+				C[1] = _mm512_ternarylogic_epi64(_mm512_ternarylogic_epi64(A[0 * 5 + 1], A[1 * 5 + 1], A[2 * 5 + 1], 0x96), A[3 * 5 + 1], A[4 * 5 + 1], 0x96);
+				C[2] = _mm512_ternarylogic_epi64(_mm512_ternarylogic_epi64(A[0 * 5 + 2], A[1 * 5 + 2], A[2 * 5 + 2], 0x96), A[3 * 5 + 2], A[4 * 5 + 2], 0x96);
+				C[3] = _mm512_ternarylogic_epi64(_mm512_ternarylogic_epi64(A[0 * 5 + 3], A[1 * 5 + 3], A[2 * 5 + 3], 0x96), A[3 * 5 + 3], A[4 * 5 + 3], 0x96);
+				C[4] = _mm512_ternarylogic_epi64(_mm512_ternarylogic_epi64(A[0 * 5 + 4], A[1 * 5 + 4], A[2 * 5 + 4], 0x96), A[3 * 5 + 4], A[4 * 5 + 4], 0x96);
+
+				D[0] = _mm512_xor_si512(C[4], _mm512_rol_epi64(C[1], 1));
+				D[1] = _mm512_xor_si512(C[0], _mm512_rol_epi64(C[2], 1));
+				D[2] = _mm512_xor_si512(C[1], _mm512_rol_epi64(C[3], 1));
+				D[3] = _mm512_xor_si512(C[2], _mm512_rol_epi64(C[4], 1));
+				D[4] = _mm512_xor_si512(C[3], _mm512_rol_epi64(C[0], 1));
+
+				__m512i B00 = _mm512_xor_si512(A[0 * 5 + 0], D[0]);
+				__m512i B10 = _mm512_rol_epi64(_mm512_xor_si512(A[0 * 5 + 1], D[1]), 1);
+				__m512i B20 = _mm512_rol_epi64(_mm512_xor_si512(A[0 * 5 + 2], D[2]), 62);
+				__m512i B5 = _mm512_rol_epi64(_mm512_xor_si512(A[0 * 5 + 3], D[3]), 28);
+				__m512i B15 = _mm512_rol_epi64(_mm512_xor_si512(A[0 * 5 + 4], D[4]), 27);
+
+				__m512i B16 = _mm512_rol_epi64(_mm512_xor_si512(A[1 * 5 + 0], D[0]), 36);
+				__m512i B1 = _mm512_rol_epi64(_mm512_xor_si512(A[1 * 5 + 1], D[1]), 44);
+				__m512i B11 = _mm512_rol_epi64(_mm512_xor_si512(A[1 * 5 + 2], D[2]), 6);
+				__m512i B21 = _mm512_rol_epi64(_mm512_xor_si512(A[1 * 5 + 3], D[3]), 55);
+				__m512i B6 = _mm512_rol_epi64(_mm512_xor_si512(A[1 * 5 + 4], D[4]), 20);
+
+				__m512i B7 = _mm512_rol_epi64(_mm512_xor_si512(A[2 * 5 + 0], D[0]), 3);
+				__m512i B17 = _mm512_rol_epi64(_mm512_xor_si512(A[2 * 5 + 1], D[1]), 10);
+				__m512i B2 = _mm512_rol_epi64(_mm512_xor_si512(A[2 * 5 + 2], D[2]), 43);
+				__m512i B12 = _mm512_rol_epi64(_mm512_xor_si512(A[2 * 5 + 3], D[3]), 25);
+				__m512i B22 = _mm512_rol_epi64(_mm512_xor_si512(A[2 * 5 + 4], D[4]), 39);
+
+				__m512i B23 = _mm512_rol_epi64(_mm512_xor_si512(A[3 * 5 + 0], D[0]), 41);
+				__m512i B8 = _mm512_rol_epi64(_mm512_xor_si512(A[3 * 5 + 1], D[1]), 45);
+				__m512i B18 = _mm512_rol_epi64(_mm512_xor_si512(A[3 * 5 + 2], D[2]), 15);
+				__m512i B3 = _mm512_rol_epi64(_mm512_xor_si512(A[3 * 5 + 3], D[3]), 21);
+				__m512i B13 = _mm512_rol_epi64(_mm512_xor_si512(A[3 * 5 + 4], D[4]), 8);
+
+				__m512i B14 = _mm512_rol_epi64(_mm512_xor_si512(A[4 * 5 + 0], D[0]), 18);
+				__m512i B24 = _mm512_rol_epi64(_mm512_xor_si512(A[4 * 5 + 1], D[1]), 2);
+				__m512i B9 = _mm512_rol_epi64(_mm512_xor_si512(A[4 * 5 + 2], D[2]), 61);
+				__m512i B19 = _mm512_rol_epi64(_mm512_xor_si512(A[4 * 5 + 3], D[3]), 56);
+				__m512i B4 = _mm512_rol_epi64(_mm512_xor_si512(A[4 * 5 + 4], D[4]), 14);
+
+				A[0 * 5 + 0] = _mm512_ternarylogic_epi64(B00, B1, B2, 0xd2);
+				A[0 * 5 + 1] = _mm512_ternarylogic_epi64(B1, B2, B3, 0xd2);
+				A[0 * 5 + 2] = _mm512_ternarylogic_epi64(B2, B3, B4, 0xd2);
+				A[0 * 5 + 3] = _mm512_ternarylogic_epi64(B3, B4, B00, 0xd2);
+				A[0 * 5 + 4] = _mm512_ternarylogic_epi64(B4, B00, B1, 0xd2);
+
+				A[1 * 5 + 0] = _mm512_ternarylogic_epi64(B5, B6, B7, 0xd2);
+				A[1 * 5 + 1] = _mm512_ternarylogic_epi64(B6, B7, B8, 0xd2);
+				A[1 * 5 + 2] = _mm512_ternarylogic_epi64(B7, B8, B9, 0xd2);
+				A[1 * 5 + 3] = _mm512_ternarylogic_epi64(B8, B9, B5, 0xd2);
+				A[1 * 5 + 4] = _mm512_ternarylogic_epi64(B9, B5, B6, 0xd2);
+
+				A[2 * 5 + 0] = _mm512_ternarylogic_epi64(B10, B11, B12, 0xd2);
+				A[2 * 5 + 1] = _mm512_ternarylogic_epi64(B11, B12, B13, 0xd2);
+				A[2 * 5 + 2] = _mm512_ternarylogic_epi64(B12, B13, B14, 0xd2);
+				A[2 * 5 + 3] = _mm512_ternarylogic_epi64(B13, B14, B10, 0xd2);
+				A[2 * 5 + 4] = _mm512_ternarylogic_epi64(B14, B10, B11, 0xd2);
+
+				A[3 * 5 + 0] = _mm512_ternarylogic_epi64(B15, B16, B17, 0xd2);
+				A[3 * 5 + 1] = _mm512_ternarylogic_epi64(B16, B17, B18, 0xd2);
+				A[3 * 5 + 2] = _mm512_ternarylogic_epi64(B17, B18, B19, 0xd2);
+				A[3 * 5 + 3] = _mm512_ternarylogic_epi64(B18, B19, B15, 0xd2);
+				A[3 * 5 + 4] = _mm512_ternarylogic_epi64(B19, B15, B16, 0xd2);
+
+				A[4 * 5 + 0] = _mm512_ternarylogic_epi64(B20, B21, B22, 0xd2);
+				A[4 * 5 + 1] = _mm512_ternarylogic_epi64(B21, B22, B23, 0xd2);
+				A[4 * 5 + 2] = _mm512_ternarylogic_epi64(B22, B23, B24, 0xd2);
+				A[4 * 5 + 3] = _mm512_ternarylogic_epi64(B23, B24, B20, 0xd2);
+				A[4 * 5 + 4] = _mm512_ternarylogic_epi64(B24, B20, B21, 0xd2);
+
+				A[0] = _mm512_xor_si512(A[0], _mm512_set1_epi64(static_cast<long long>(sha3_constants<void>::RC[round])));
+			}
+		}
+
+		for (int i = 0; i < 25; i++)
+			_mm512_storeu_si512(S + i * 8, A[i]);
+	}
+#endif
+
+	// Number of states processed at once by the best kernel available on this CPU (1 if there is none)
+	inline size_t lanes()
+	{
+#ifdef DIGESTPP_X86_SIMD
+		const cpu_features& cpu = cpu_features::get();
+		if (cpu.avx512)
+			return 8;
+		if (cpu.avx2)
+			return 4;
+#endif
+		return 1;
+	}
+
+	// Absorb blocks into n states (as returned by lanes()) with the matching kernel
+	template<int R>
+	inline void absorb(size_t n, uint64_t* S, const unsigned char* const* data, size_t num_blks, size_t rate_words)
+	{
+#ifdef DIGESTPP_X86_SIMD
+		if (n == 8)
+			return absorb_x8_avx512<R>(S, data, num_blks, rate_words);
+		if (n == 4)
+			return absorb_x4_avx2<R>(S, data, num_blks, rate_words);
+#endif
+		(void)n;
+		absorb_x1<R>(S, data, num_blks, rate_words);
+	}
+
+	// Hash n consecutive messages of chunk_size bytes each (e.g. leaves of a hash tree), L at a time.
+	// out_len bytes of output (not more than the rate) are written per message.
+	template<int R>
+	inline void hash_chunks(size_t L, const unsigned char* data, size_t n, size_t chunk_size,
+			size_t rate, unsigned char domain, unsigned char* out, size_t out_len)
+	{
+		uint64_t S[25 * 8];
+		unsigned char pad[8 * 168];
+		const unsigned char* blocks[8];
+		size_t full = chunk_size / rate;
+		size_t rem = chunk_size % rate;
+		for (size_t i = 0; i < n; )
+		{
+			size_t lanes = n - i >= L ? L : 1;
+			memset(S, 0, sizeof(S));
+			for (size_t l = 0; l < lanes; l++)
+				blocks[l] = data + (i + l) * chunk_size;
+			absorb<R>(lanes, S, blocks, full, rate / 8);
+
+			for (size_t l = 0; l < lanes; l++)
+			{
+				unsigned char* p = pad + l * rate;
+				memset(p, 0, rate);
+				memcpy(p, blocks[l] + full * rate, rem);
+				p[rem] ^= domain;
+				p[rate - 1] ^= 0x80;
+				blocks[l] = p;
+			}
+			absorb<R>(lanes, S, blocks, 1, rate / 8);
+
+			for (size_t l = 0; l < lanes; l++)
+				for (size_t b = 0; b < out_len; b++)
+					out[(i + l) * out_len + b] = static_cast<unsigned char>(S[(b / 8) * lanes + l] >> (b % 8 * 8));
+			i += lanes;
+		}
+		zero_memory(S, sizeof(S));
+		zero_memory(pad, sizeof(pad));
+	}
+
+	// Hash independent messages with a Keccak sponge, one message per lane.
+	// Each message is padded with the domain byte, and out_len bytes of output are written per message.
+	// When a lane finishes, its output is written and the next message is loaded.
+	template<int R>
+	inline void hash_batch(size_t L, const unsigned char* const* data, const size_t* len, size_t count,
+			unsigned char* out, size_t out_len, size_t rate, unsigned char domain)
+	{
+		enum phase { absorbing, padding, squeezing };
+		struct lane
+		{
+			size_t msg;
+			size_t blocks; // blocks of message data left
+			size_t done;   // output bytes written
+			phase ph;
+		};
+
+		const size_t idle = static_cast<size_t>(-1);
+		static const unsigned char zero[168] = {};
+		std::vector<uint64_t> S(25 * L);
+		std::vector<unsigned char> pad(168 * L);
+		std::vector<const unsigned char*> blocks(L);
+		std::vector<lane> lanes(L);
+		size_t next = 0, active = 0;
+
+		auto start = [&](size_t l)
+		{
+			lane& ln = lanes[l];
+			for (size_t w = 0; w < 25; w++)
+				S[w * L + l] = 0;
+			if (next == count)
+			{
+				ln.msg = idle;
+				blocks[l] = zero;
+				return;
+			}
+			ln.msg = next++;
+			ln.blocks = len[ln.msg] / rate;
+			ln.done = 0;
+			ln.ph = absorbing;
+			blocks[l] = data[ln.msg];
+			active++;
+		};
+
+		// The last block holds the rest of the message, the domain byte and the final bit
+		auto start_padding = [&](size_t l)
+		{
+			lane& ln = lanes[l];
+			size_t rem = len[ln.msg] % rate;
+			unsigned char* p = &pad[l * 168];
+			memset(p, 0, rate);
+			if (rem)
+				memcpy(p, data[ln.msg] + len[ln.msg] - rem, rem);
+			p[rem] ^= domain;
+			p[rate - 1] ^= 0x80;
+			ln.ph = padding;
+			blocks[l] = p;
+		};
+
+		for (size_t l = 0; l < L; l++)
+		{
+			start(l);
+			if (lanes[l].msg != idle && !lanes[l].blocks)
+				start_padding(l);
+		}
+		while (active)
+		{
+			absorb<R>(L, S.data(), blocks.data(), 1, rate / 8);
+			for (size_t l = 0; l < L; l++)
+			{
+				lane& ln = lanes[l];
+				if (ln.msg == idle)
+					continue;
+				if (ln.ph == absorbing)
+				{
+					blocks[l] += rate;
+					if (!--ln.blocks)
+						start_padding(l);
+					continue;
+				}
+
+				// The state holds the next rate bytes of output
+				unsigned char* o = out + ln.msg * out_len;
+				size_t n = std::min(out_len - ln.done, rate);
+				for (size_t i = 0; i < n; i++)
+					o[ln.done + i] = static_cast<unsigned char>(S[(i / 8) * L + l] >> (i % 8 * 8));
+				ln.done += n;
+				if (ln.done < out_len)
+				{
+					ln.ph = squeezing;
+					blocks[l] = zero;
+					continue;
+				}
+				active--;
+				start(l);
+				if (lanes[l].msg != idle && !lanes[l].blocks)
+					start_padding(l);
+			}
+		}
+		zero_memory(S.data(), S.size() * sizeof(uint64_t));
+		zero_memory(pad.data(), pad.size());
+	}
+}
+
+} // namespace detail
+
+} // namespace digestpp
+
+#endif // DIGESTPP_PROVIDERS_SHA3_SIMD_HPP
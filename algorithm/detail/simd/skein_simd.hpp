@@ -0,0 +1,466 @@
+/*
+This code is written by kerukuro and released into public domain.
+*/
+
+#ifndef DIGESTPP_PROVIDERS_SKEIN_SIMD_HPP
+#define DIGESTPP_PROVIDERS_SKEIN_SIMD_HPP
+
+#include "../../../detail/cpu_features.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+namespace digestpp
+{
+
+namespace detail
+{
+
+namespace skein_simd
+{
+	// Threefish-512 and Threefish-1024 with the even words of the state in one set of vectors and the odd words
+	// in another, so that one vector instruction performs four (or eight) MIX operations.
+	// Odd words never move; the permutation of each round only reorders the even words, which keeps it
+	// off the dependency chain of the odd words. After four rounds all words are back in order,
+	// which is where the subkeys are injected.
+	//
+	// Rotation counts of rounds 0-7 for each lane, in the order of the odd words.
+	// The even words are stored in the following order in rounds 0-3 (and 4-7):
+	// Threefish-512: { 0, 2, 4, 6 }, { 2, 0, 6, 4 }, { 4, 6, 0, 2 }, { 6, 4, 2, 0 }
+	// Threefish-1024: { 0, 2, 4, 6, 8, 10, 12, 14 }, { 8, 12, 14, 10, 0, 6, 2, 4 },
+	//                 { 6, 4, 2, 0, 10, 8, 14, 12 }, { 14, 10, 8, 12, 4, 2, 6, 0 }
+	template<typename T>
+	struct rotations
+	{
+		const static uint64_t R512[8][4];
+		const static uint64_t R1024[8][8];
+	};
+
+	template<typename T>
+	const uint64_t rotations<T>::R512[8][4] = {
+		{ 46, 36, 19, 37 }, { 33, 42, 14, 27 }, { 17, 49, 36, 39 }, { 44, 56, 54, 9 },
+		{ 39, 30, 34, 24 }, { 13, 17, 10, 50 }, { 25, 29, 39, 43 }, { 8, 22, 56, 35 }
+	};
+
+	template<typename T>
+	const uint64_t rotations<T>::R1024[8][8] = {
+		{ 24, 13, 8, 47, 8, 17, 22, 37 }, { 52, 18, 23, 49, 38, 10, 19, 55 },
+		{ 13, 51, 4, 33, 17, 59, 41, 34 }, { 47, 16, 28, 25, 41, 20, 48, 5 },
+		{ 41, 9, 37, 31, 12, 47, 44, 30 }, { 41, 53, 42, 4, 16, 56, 34, 51 },
+		{ 46, 47, 44, 31, 25, 44, 42, 19 }, { 23, 37, 31, 20, 52, 48, 35, 9 }
+	};
+
+#ifdef DIGESTPP_X86_SIMD
+	// Key schedule: the key words are stored in the order k0, k2, ..., k(W), k1, k3, ..., k(W - 1), twice.
+	// In this order the even words of subkey s (key words s, s + 2, s + 4, ... mod W + 1) are consecutive,
+	// starting at index s * (W / 2 + 1) mod (W + 1), and the odd words of subkey s are the even words of subkey s + 1.
+	// The tweak words are added to the last three words of the subkey.
+	template<size_t W>
+	struct key_ring
+	{
+		uint64_t k[2 * (W + 1)];
+
+		template<int s>
+		const uint64_t* subkey() const
+		{
+			return k + s * (W / 2 + 1) % (W + 1);
+		}
+	};
+
+	template<int a, int b, int c, int d>
+	DIGESTPP_TARGET("avx2")
+	inline __m256i permute_avx2(__m256i x)
+	{
+		return _mm256_permute4x64_epi64(x, a | (b << 2) | (c << 4) | (d << 6));
+	}
+
+	// Split 8 consecutive words into even and odd words
+	DIGESTPP_TARGET("avx2")
+	inline void deinterleave_avx2(const void* p, __m256i& even, __m256i& odd)
+	{
+		__m256i lo = _mm256_loadu_si256(static_cast<const __m256i*>(p));
+		__m256i hi = _mm256_loadu_si256(static_cast<const __m256i*>(p) + 1);
+		even = permute_avx2<0, 2, 1, 3>(_mm256_unpacklo_epi64(lo, hi));
+		odd = permute_avx2<0, 2, 1, 3>(_mm256_unpackhi_epi64(lo, hi));
+	}
+
+	DIGESTPP_TARGET("avx2")
+	inline void interleave_avx2(void* p, __m256i even, __m256i odd)
+	{
+		__m256i lo = _mm256_unpacklo_epi64(even, odd);
+		__m256i hi = _mm256_unpackhi_epi64(even, odd);
+		_mm256_storeu_si256(static_cast<__m256i*>(p), _mm256_permute2x128_si256(lo, hi, 0x20));
+		_mm256_storeu_si256(static_cast<__m256i*>(p) + 1, _mm256_permute2x128_si256(lo, hi, 0x31));
+	}
+
+	// XOR of all words of x with the key schedule constant, in every element
+	DIGESTPP_TARGET("avx2")
+	inline __m256i parity_avx2(__m256i x)
+	{
+		x = _mm256_xor_si256(x, permute_avx2<2, 3, 0, 1>(x));
+		x = _mm256_xor_si256(x, _mm256_shuffle_epi32(x, 0x4e));
+		return _mm256_xor_si256(x, _mm256_set1_epi64x(0x1BD11BDAA9FC1A22LL));
+	}
+
+	// Tweak words added to the last 8 words of subkey s, for s mod 3 = 0, 1, 2
+	DIGESTPP_TARGET("avx2")
+	inline void tweak_words_avx2(const uint64_t* tweak, __m256i* even, __m256i* odd)
+	{
+		const long long t[3] = { static_cast<long long>(tweak[0]), static_cast<long long>(tweak[1]),
+				static_cast<long long>(tweak[0] ^ tweak[1]) };
+		for (int i = 0; i < 3; i++)
+		{
+			even[i] = _mm256_set_epi64x(t[(i + 1) % 3], 0, 0, 0);
+			odd[i] = _mm256_set_epi64x(0, t[i], 0, 0);
+		}
+	}
+
+	DIGESTPP_TARGET("avx2")
+	inline __m256i rotl_avx2(__m256i x, const uint64_t* r)
+	{
+		__m256i n = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(r));
+		return _mm256_or_si256(_mm256_sllv_epi64(x, n), _mm256_srlv_epi64(x, _mm256_sub_epi64(_mm256_set1_epi64x(64), n)));
+	}
+
+	DIGESTPP_TARGET("avx512f,avx512vl")
+	inline __m256i rotl_avx512(__m256i x, const uint64_t* r)
+	{
+		return _mm256_rolv_epi64(x, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(r)));
+	}
+
+	DIGESTPP_TARGET("avx2")
+	inline __m256i load_avx2(const uint64_t* p)
+	{
+		return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p));
+	}
+
+	// Threefish-512: E holds the even words and O the odd words
+	DIGESTPP_TARGET("avx2")
+	inline void init_keys512_avx2(key_ring<8>& K, __m256i HE, __m256i HO)
+	{
+		__m256i parity = parity_avx2(_mm256_xor_si256(HE, HO));
+		for (int i = 0; i < 18; i += 9)
+		{
+			_mm256_storeu_si256(reinterpret_cast<__m256i*>(K.k + i), HE);
+			_mm_storel_epi64(reinterpret_cast<__m128i*>(K.k + i + 4), _mm256_castsi256_si128(parity));
+			_mm256_storeu_si256(reinterpret_cast<__m256i*>(K.k + i + 5), HO);
+		}
+	}
+
+	template<int s>
+	DIGESTPP_TARGET("avx2")
+	inline void add_subkey512_avx2(__m256i& E, __m256i& O, const key_ring<8>& K, const __m256i* TE, const __m256i* TO)
+	{
+		E = _mm256_add_epi64(E, _mm256_add_epi64(load_avx2(K.template subkey<s>()), TE[s % 3]));
+		O = _mm256_add_epi64(O, _mm256_add_epi64(load_avx2(K.template subkey<s + 1>()),
+				_mm256_add_epi64(TO[s % 3], _mm256_set_epi64x(s, 0, 0, 0))));
+	}
+
+	// Threefish-512 round: MIX on all pairs, then the permutation: the even words are swapped
+	// within 128-bit halves after even rounds and reversed after odd rounds
+	template<int r>
+	DIGESTPP_TARGET("avx512f,avx512vl")
+	inline void round512_avx512(__m256i& E, __m256i& O)
+	{
+		E = _mm256_add_epi64(E, O);
+		O = _mm256_xor_si256(rotl_avx512(O, rotations<void>::R512[r]), E);
+		E = r % 2 ? _mm256_permute4x64_epi64(E, 0x1b) : _mm256_shuffle_epi32(E, 0x4e);
+	}
+
+	template<int s>
+	DIGESTPP_TARGET("avx512f,avx512vl")
+	inline void rounds512_avx512(__m256i& E, __m256i& O, const key_ring<8>& K, const __m256i* TE, const __m256i* TO)
+	{
+		round512_avx512<0>(E, O);
+		round512_avx512<1>(E, O);
+		round512_avx512<2>(E, O);
+		round512_avx512<3>(E, O);
+		add_subkey512_avx2<s + 1>(E, O, K, TE, TO);
+		round512_avx512<4>(E, O);
+		round512_avx512<5>(E, O);
+		round512_avx512<6>(E, O);
+		round512_avx512<7>(E, O);
+		add_subkey512_avx2<s + 2>(E, O, K, TE, TO);
+	}
+
+	// UBI compression of num_blks blocks with Threefish-512; the interface is the same as in skein_provider
+	DIGESTPP_TARGET("avx512f,avx512vl")
+	inline void transform512_avx512(uint64_t* H, uint64_t* tweak, const unsigned char* data, uint64_t num_blks, size_t reallen)
+	{
+		__m256i HE, HO;
+		deinterleave_avx2(H, HE, HO);
+		for (uint64_t b = 0; b < num_blks; b++, data += 64)
+		{
+			tweak[0] += reallen;
+			__m256i TE[3], TO[3], ME, MO;
+			tweak_words_avx2(tweak, TE, TO);
+			deinterleave_avx2(data, ME, MO);
+			key_ring<8> K;
+			init_keys512_avx2(K, HE, HO);
+			__m256i E = _mm256_add_epi64(ME, _mm256_add_epi64(HE, TE[0]));
+			__m256i O = _mm256_add_epi64(MO, _mm256_add_epi64(HO, TO[0]));
+			rounds512_avx512<0>(E, O, K, TE, TO);
+			rounds512_avx512<2>(E, O, K, TE, TO);
+			rounds512_avx512<4>(E, O, K, TE, TO);
+			rounds512_avx512<6>(E, O, K, TE, TO);
+			rounds512_avx512<8>(E, O, K, TE, TO);
+			rounds512_avx512<10>(E, O, K, TE, TO);
+			rounds512_avx512<12>(E, O, K, TE, TO);
+			rounds512_avx512<14>(E, O, K, TE, TO);
+			rounds512_avx512<16>(E, O, K, TE, TO);
+			HE = _mm256_xor_si256(E, ME);
+			HO = _mm256_xor_si256(O, MO);
+			tweak[1] &= ~(64ULL << 56);
+		}
+		interleave_avx2(H, HE, HO);
+	}
+
+	// Threefish-1024 with the words in two pairs of vectors (E0, O0: words 0-7, E1, O1: words 8-15).
+	// The permutation moves every even word to the other half of the state.
+	// The key schedule is the same as for Threefish-512, with two vectors per subkey.
+	DIGESTPP_TARGET("avx2")
+	inline void init_keys1024_avx2(key_ring<16>& K, __m256i HE0, __m256i HO0, __m256i HE1, __m256i HO1)
+	{
+		__m256i parity = parity_avx2(_mm256_xor_si256(_mm256_xor_si256(HE0, HO0), _mm256_xor_si256(HE1, HO1)));
+		for (int i = 0; i < 34; i += 17)
+		{
+			_mm256_storeu_si256(reinterpret_cast<__m256i*>(K.k + i), HE0);
+			_mm256_storeu_si256(reinterpret_cast<__m256i*>(K.k + i + 4), HE1);
+			_mm_storel_epi64(reinterpret_cast<__m128i*>(K.k + i + 8), _mm256_castsi256_si128(parity));
+			_mm256_storeu_si256(reinterpret_cast<__m256i*>(K.k + i + 9), HO0);
+			_mm256_storeu_si256(reinterpret_cast<__m256i*>(K.k + i + 13), HO1);
+		}
+	}
+
+	template<int s>
+	DIGESTPP_TARGET("avx2")
+	inline void add_subkey1024_avx2(__m256i& E0, __m256i& O0, __m256i& E1, __m256i& O1, const key_ring<16>& K,
+			const __m256i* TE, const __m256i* TO)
+	{
+		E0 = _mm256_add_epi64(E0, load_avx2(K.template subkey<s>()));
+		E1 = _mm256_add_epi64(E1, _mm256_add_epi64(load_avx2(K.template subkey<s>() + 4), TE[s % 3]));
+		O0 = _mm256_add_epi64(O0, load_avx2(K.template subkey<s + 1>()));
+		O1 = _mm256_add_epi64(O1, _mm256_add_epi64(load_avx2(K.template subkey<s + 1>() + 4),
+				_mm256_add_epi64(TO[s % 3], _mm256_set_epi64x(s, 0, 0, 0))));
+	}
+
+	template<int r, int a0, int a1, int a2, int a3, int b0, int b1, int b2, int b3>
+	DIGESTPP_TARGET("avx2")
+	inline void round1024_avx2(__m256i& E0, __m256i& O0, __m256i& E1, __m256i& O1)
+	{
+		__m256i T0 = _mm256_add_epi64(E0, O0);
+		__m256i T1 = _mm256_add_epi64(E1, O1);
+		O0 = _mm256_xor_si256(rotl_avx2(O0, rotations<void>::R1024[r]), T0);
+		O1 = _mm256_xor_si256(rotl_avx2(O1, rotations<void>::R1024[r] + 4), T1);
+		E0 = permute_avx2<a0, a1, a2, a3>(T1);
+		E1 = permute_avx2<b0, b1, b2, b3>(T0);
+	}
+
+	template<int r>
+	DIGESTPP_TARGET("avx2")
+	inline void round1024_avx2(__m256i& E0, __m256i& O0, __m256i& E1, __m256i& O1)
+	{
+		switch (r % 4)
+		{
+			case 0: return round1024_avx2<r, 0, 2, 3, 1, 0, 3, 1, 2>(E0, O0, E1, O1);
+			case 1: return round1024_avx2<r, 1, 3, 2, 0, 3, 0, 2, 1>(E0, O0, E1, O1);
+			case 2: return round1024_avx2<r, 2, 0, 1, 3, 1, 2, 0, 3>(E0, O0, E1, O1);
+			default: return round1024_avx2<r, 3, 1, 0, 2, 2, 1, 3, 0>(E0, O0, E1, O1);
+		}
+	}
+
+	template<int s>
+	DIGESTPP_TARGET("avx2")
+	inline void rounds1024_avx2(__m256i& E0, __m256i& O0, __m256i& E1, __m256i& O1, const key_ring<16>& K,
+			const __m256i* TE, const __m256i* TO)
+	{
+		round1024_avx2<0>(E0, O0, E1, O1);
+		round1024_avx2<1>(E0, O0, E1, O1);
+		round1024_avx2<2>(E0, O0, E1, O1);
+		round1024_avx2<3>(E0, O0, E1, O1);
+		add_subkey1024_avx2<s + 1>(E0, O0, E1, O1, K, TE, TO);
+		round1024_avx2<4>(E0, O0, E1, O1);
+		round1024_avx2<5>(E0, O0, E1, O1);
+		round1024_avx2<6>(E0, O0, E1, O1);
+		round1024_avx2<7>(E0, O0, E1, O1);
+		add_subkey1024_avx2<s + 2>(E0, O0, E1, O1, K, TE, TO);
+	}
+
+	DIGESTPP_TARGET("avx2")
+	inline void transform1024_avx2(uint64_t* H, uint64_t* tweak, const unsigned char* data, uint64_t num_blks, size_t reallen)
+	{
+		__m256i HE0, HO0, HE1, HO1;
+		deinterleave_avx2(H, HE0, HO0);
+		deinterleave_avx2(H + 8, HE1, HO1);
+		for (uint64_t b = 0; b < num_blks; b++, data += 128)
+		{
+			tweak[0] += reallen;
+			__m256i TE[3], TO[3], ME0, MO0, ME1, MO1;
+			tweak_words_avx2(tweak, TE, TO);
+			deinterleave_avx2(data, ME0, MO0);
+			deinterleave_avx2(data + 64, ME1, MO1);
+			key_ring<16> K;
+			init_keys1024_avx2(K, HE0, HO0, HE1, HO1);
+			__m256i E0 = _mm256_add_epi64(ME0, HE0);
+			__m256i O0 = _mm256_add_epi64(MO0, HO0);
+			__m256i E1 = _mm256_add_epi64(ME1, _mm256_add_epi64(HE1, TE[0]));
+			__m256i O1 = _mm256_add_epi64(MO1, _mm256_add_epi64(HO1, TO[0]));
+			rounds1024_avx2<0>(E0, O0, E1, O1, K, TE, TO);
+			rounds1024_avx2<2>(E0, O0, E1, O1, K, TE, TO);
+			rounds1024_avx2<4>(E0, O0, E1, O1, K, TE, TO);
+			rounds1024_avx2<6>(E0, O0, E1, O1, K, TE, TO);
+			rounds1024_avx2<8>(E0, O0, E1, O1, K, TE, TO);
+			rounds1024_avx2<10>(E0, O0, E1, O1, K, TE, TO);
+			rounds1024_avx2<12>(E0, O0, E1, O1, K, TE, TO);
+			rounds1024_avx2<14>(E0, O0, E1, O1, K, TE, TO);
+			rounds1024_avx2<16>(E0, O0, E1, O1, K, TE, TO);
+			rounds1024_avx2<18>(E0, O0, E1, O1, K, TE, TO);
+			HE0 = _mm256_xor_si256(E0, ME0);
+			HO0 = _mm256_xor_si256(O0, MO0);
+			HE1 = _mm256_xor_si256(E1, ME1);
+			HO1 = _mm256_xor_si256(O1, MO1);
+			tweak[1] &= ~(64ULL << 56);
+		}
+		interleave_avx2(H, HE0, HO0);
+		interleave_avx2(H + 8, HE1, HO1);
+	}
+
+	// Threefish-1024 with AVX-512: all even words in one vector and all odd words in another
+	DIGESTPP_TARGET("avx512f")
+	inline void deinterleave_avx512(const void* p, __m512i& even, __m512i& odd)
+	{
+		__m512i lo = _mm512_loadu_si512(p);
+		__m512i hi = _mm512_loadu_si512(static_cast<const uint64_t*>(p) + 8);
+		even = _mm512_permutex2var_epi64(lo, _mm512_set_epi64(14, 12, 10, 8, 6, 4, 2, 0), hi);
+		odd = _mm512_permutex2var_epi64(lo, _mm512_set_epi64(15, 13, 11, 9, 7, 5, 3, 1), hi);
+	}
+
+	DIGESTPP_TARGET("avx512f")
+	inline void interleave_avx512(void* p, __m512i even, __m512i odd)
+	{
+		_mm512_storeu_si512(p, _mm512_permutex2var_epi64(even, _mm512_set_epi64(11, 3, 10, 2, 9, 1, 8, 0), odd));
+		_mm512_storeu_si512(static_cast<uint64_t*>(p) + 8,
+				_mm512_permutex2var_epi64(even, _mm512_set_epi64(15, 7, 14, 6, 13, 5, 12, 4), odd));
+	}
+
+	template<int s>
+	DIGESTPP_TARGET("avx512f")
+	inline void add_subkey1024_avx512(__m512i& E, __m512i& O, const key_ring<16>& K, const __m512i* TE, const __m512i* TO)
+	{
+		E = _mm512_add_epi64(E, _mm512_add_epi64(_mm512_loadu_si512(K.template subkey<s>()), TE[s % 3]));
+		O = _mm512_add_epi64(O, _mm512_add_epi64(_mm512_loadu_si512(K.template subkey<s + 1>()),
+				_mm512_add_epi64(TO[s % 3], _mm512_set_epi64(s, 0, 0, 0, 0, 0, 0, 0))));
+	}
+
+	template<int r>
+	DIGESTPP_TARGET("avx512f")
+	inline void round1024_avx512(__m512i& E, __m512i& O)
+	{
+		static const long long P[4][8] = {
+			{ 4, 6, 7, 5, 0, 3, 1, 2 }, { 5, 7, 6, 4, 3, 0, 2, 1 },
+			{ 6, 4, 5, 7, 1, 2, 0, 3 }, { 7, 5, 4, 6, 2, 1, 3, 0 }
+		};
+		E = _mm512_add_epi64(E, O);
+		O = _mm512_xor_si512(_mm512_rolv_epi64(O, _mm512_loadu_si512(rotations<void>::R1024[r])), E);
+		E = _mm512_permutexvar_epi64(_mm512_loadu_si512(P[r % 4]), E);
+	}
+
+	template<int s>
+	DIGESTPP_TARGET("avx512f")
+	inline void rounds1024_avx512(__m512i& E, __m512i& O, const key_ring<16>& K, const __m512i* TE, const __m512i* TO)
+	{
+		round1024_avx512<0>(E, O);
+		round1024_avx512<1>(E, O);
+		round1024_avx512<2>(E, O);
+		round1024_avx512<3>(E, O);
+		add_subkey1024_avx512<s + 1>(E, O, K, TE, TO);
+		round1024_avx512<4>(E, O);
+		round1024_avx512<5>(E, O);
+		round1024_avx512<6>(E, O);
+		round1024_avx512<7>(E, O);
+		add_subkey1024_avx512<s + 2>(E, O, K, TE, TO);
+	}
+
+	DIGESTPP_TARGET("avx512f")
+	inline void transform1024_avx512(uint64_t* H, uint64_t* tweak, const unsigned char* data, uint64_t num_blks, size_t reallen)
+	{
+		__m512i HE, HO;
+		deinterleave_avx512(H, HE, HO);
+		for (uint64_t b = 0; b < num_blks; b++, data += 128)
+		{
+			tweak[0] += reallen;
+			const long long t[3] = { static_cast<long long>(tweak[0]), static_cast<long long>(tweak[1]),
+					static_cast<long long>(tweak[0] ^ tweak[1]) };
+			__m512i TE[3], TO[3], ME, MO;
+			for (int i = 0; i < 3; i++)
+			{
+				TE[i] = _mm512_set_epi64(t[(i + 1) % 3], 0, 0, 0, 0, 0, 0, 0);
+				TO[i] = _mm512_set_epi64(0, t[i], 0, 0, 0, 0, 0, 0);
+			}
+			deinterleave_avx512(data, ME, MO);
+			__m512i x = _mm512_xor_si512(HE, HO);
+			x = _mm512_xor_si512(x, _mm512_shuffle_i64x2(x, x, 0x4e));
+			x = _mm512_xor_si512(x, _mm512_shuffle_i64x2(x, x, 0xb1));
+			x = _mm512_xor_si512(x, _mm512_shuffle_epi32(x, _MM_PERM_BADC));
+			x = _mm512_xor_si512(x, _mm512_set1_epi64(0x1BD11BDAA9FC1A22LL));
+			key_ring<16> K;
+			for (int i = 0; i < 34; i += 17)
+			{
+				_mm512_storeu_si512(K.k + i, HE);
+				_mm_storel_epi64(reinterpret_cast<__m128i*>(K.k + i + 8), _mm512_castsi512_si128(x));
+				_mm512_storeu_si512(K.k + i + 9, HO);
+			}
+			__m512i E = _mm512_add_epi64(ME, _mm512_add_epi64(HE, TE[0]));
+			__m512i O = _mm512_add_epi64(MO, _mm512_add_epi64(HO, TO[0]));
+			rounds1024_avx512<0>(E, O, K, TE, TO);
+			rounds1024_avx512<2>(E, O, K, TE, TO);
+			rounds1024_avx512<4>(E, O, K, TE, TO);
+			rounds1024_avx512<6>(E, O, K, TE, TO);
+			rounds1024_avx512<8>(E, O, K, TE, TO);
+			rounds1024_avx512<10>(E, O, K, TE, TO);
+			rounds1024_avx512<12>(E, O, K, TE, TO);
+			rounds1024_avx512<14>(E, O, K, TE, TO);
+			rounds1024_avx512<16>(E, O, K, TE, TO);
+			rounds1024_avx512<18>(E, O, K, TE, TO);
+			HE = _mm512_xor_si512(E, ME);
+			HO = _mm512_xor_si512(O, MO);
+			tweak[1] &= ~(64ULL << 56);
+		}
+		interleave_avx512(H, HE, HO);
+	}
+#endif
+
+	// UBI compression of num_blks blocks of W 64-bit words with the best kernel available on this CPU.
+	// The tweak position is incremented by reallen before each block, and the first block flag is cleared after it.
+	// Returns false if no kernel is available for the CPU or the block size.
+	template<size_t W>
+	inline bool transform(uint64_t* H, uint64_t* tweak, const unsigned char* data, uint64_t num_blks, size_t reallen)
+	{
+#ifdef DIGESTPP_X86_SIMD
+		const cpu_features& cpu = cpu_features::get();
+		if (W == 8 && cpu.avx512)
+			transform512_avx512(H, tweak, data, num_blks, reallen);
+		else if (W == 16 && cpu.avx512)
+			transform1024_avx512(H, tweak, data, num_blks, reallen);
+		else if (W == 16 && cpu.avx2)
+			transform1024_avx2(H, tweak, data, num_blks, reallen);
+		else
+			return false;
+		return true;
+#else
+		(void)H;
+		(void)tweak;
+		(void)data;
+		(void)num_blks;
+		(void)reallen;
+		return false;
+#endif
+	}
+
+} // namespace skein_simd
+
+} // namespace detail
+
+} // namespace digestpp
+
+#endif // DIGESTPP_PROVIDERS_SKEIN_SIMD_HPP
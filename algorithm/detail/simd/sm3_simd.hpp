@@ -0,0 +1,222 @@
+/*
+This code is written by kerukuro and released into public domain.
+*/
+
+#ifndef DIGESTPP_PROVIDERS_SM3_SIMD_HPP
+#define DIGESTPP_PROVIDERS_SM3_SIMD_HPP
+
+#include "../../../detail/cpu_features.hpp"
+#include "../multi_buffer.hpp"
+#include <cstddef>
+#include <cstdint>
+
+namespace digestpp
+{
+
+namespace detail
+{
+
+namespace sm3_simd
+{
+	template<typename T>
+	struct constants
+	{
+		// Round constants rotated left by the round number
+		const static uint32_t K[64];
+	};
+
+	template<typename T>
+	const uint32_t constants<T>::K[64] = {
+		0x79cc4519, 0xf3988a32, 0xe7311465, 0xce6228cb, 0x9cc45197, 0x3988a32f, 0x7311465e, 0xe6228cbc,
+		0xcc451979, 0x988a32f3, 0x311465e7, 0x6228cbce, 0xc451979c, 0x88a32f39, 0x11465e73, 0x228cbce6,
+		0x9d8a7a87, 0x3b14f50f, 0x7629ea1e, 0xec53d43c, 0xd8a7a879, 0xb14f50f3, 0x629ea1e7, 0xc53d43ce,
+		0x8a7a879d, 0x14f50f3b, 0x29ea1e76, 0x53d43cec, 0xa7a879d8, 0x4f50f3b1, 0x9ea1e762, 0x3d43cec5,
+		0x7a879d8a, 0xf50f3b14, 0xea1e7629, 0xd43cec53, 0xa879d8a7, 0x50f3b14f, 0xa1e7629e, 0x43cec53d,
+		0x879d8a7a, 0x0f3b14f5, 0x1e7629ea, 0x3cec53d4, 0x79d8a7a8, 0xf3b14f50, 0xe7629ea1, 0xcec53d43,
+		0x9d8a7a87, 0x3b14f50f, 0x7629ea1e, 0xec53d43c, 0xd8a7a879, 0xb14f50f3, 0x629ea1e7, 0xc53d43ce,
+		0x8a7a879d, 0x14f50f3b, 0x29ea1e76, 0x53d43cec, 0xa7a879d8, 0x4f50f3b1, 0x9ea1e762, 0x3d43cec5
+	};
+
+#ifdef DIGESTPP_X86_SIMD
+	// SM3 message expansion with SSSE3, four words at a time.
+	// W[t] depends on W[t - 3], so the fourth word of each vector is computed without the term from the first
+	// word, which is added afterwards; P1 is linear, so the term can be computed separately.
+
+	template<int n>
+	DIGESTPP_TARGET("ssse3")
+	inline __m128i rotl_sse(__m128i x)
+	{
+		return _mm_or_si128(_mm_slli_epi32(x, n), _mm_srli_epi32(x, 32 - n));
+	}
+
+	DIGESTPP_TARGET("ssse3")
+	inline __m128i p1_sse(__m128i x)
+	{
+		return _mm_xor_si128(_mm_xor_si128(x, rotl_sse<15>(x)), rotl_sse<23>(x));
+	}
+
+	DIGESTPP_TARGET("ssse3")
+	inline void expand_ssse3(const unsigned char* block, uint32_t* W, uint32_t* W2)
+	{
+		const __m128i bswap = _mm_set_epi64x(0x0c0d0e0f08090a0bull, 0x0405060700010203ull);
+		__m128i w[17];
+		for (int i = 0; i < 4; i++)
+			w[i] = _mm_shuffle_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(block + i * 16)), bswap);
+		for (int i = 4; i < 17; i++)
+		{
+			__m128i a = w[i - 4], b = w[i - 3], c = w[i - 2], d = w[i - 1];
+			__m128i x = _mm_xor_si128(_mm_xor_si128(a, _mm_alignr_epi8(c, b, 12)), rotl_sse<15>(_mm_srli_si128(d, 4)));
+			__m128i y = _mm_xor_si128(_mm_xor_si128(p1_sse(x), rotl_sse<7>(_mm_alignr_epi8(b, a, 12))), _mm_alignr_epi8(d, c, 8));
+			w[i] = _mm_xor_si128(y, p1_sse(rotl_sse<15>(_mm_slli_si128(y, 12))));
+		}
+		for (int i = 0; i < 17; i++)
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(W + i * 4), w[i]);
+		for (int i = 0; i < 16; i++)
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(W2 + i * 4), _mm_xor_si128(w[i], w[i + 1]));
+	}
+
+	// Multi-buffer SM3: each vector element belongs to a different message.
+	// The state is stored as state[word * lanes + lane], so that one vector holds a word of all lanes.
+
+	template<int n>
+	DIGESTPP_TARGET("avx2")
+	inline __m256i rotl_avx2(__m256i x)
+	{
+		return _mm256_or_si256(_mm256_slli_epi32(x, n), _mm256_srli_epi32(x, 32 - n));
+	}
+
+	DIGESTPP_TARGET("avx2")
+	inline __m256i p0_avx2(__m256i x)
+	{
+		return _mm256_xor_si256(_mm256_xor_si256(x, rotl_avx2<9>(x)), rotl_avx2<17>(x));
+	}
+
+	DIGESTPP_TARGET("avx2")
+	inline __m256i p1_avx2(__m256i x)
+	{
+		return _mm256_xor_si256(_mm256_xor_si256(x, rotl_avx2<15>(x)), rotl_avx2<23>(x));
+	}
+
+	// One round; the new values of A and E are written to d and h, and the words are renamed by the caller
+	template<bool first>
+	DIGESTPP_TARGET("avx2")
+	inline void round_avx2(__m256i a, __m256i& b, __m256i c, __m256i& d, __m256i e, __m256i& f, __m256i g, __m256i& h,
+			uint32_t k, __m256i w, __m256i w2)
+	{
+		__m256i a12 = rotl_avx2<12>(a);
+		__m256i ss1 = rotl_avx2<7>(_mm256_add_epi32(_mm256_add_epi32(a12, e), _mm256_set1_epi32(static_cast<int>(k))));
+		__m256i ss2 = _mm256_xor_si256(ss1, a12);
+		__m256i ff = first ? _mm256_xor_si256(_mm256_xor_si256(a, b), c)
+			: _mm256_or_si256(_mm256_and_si256(a, b), _mm256_and_si256(c, _mm256_or_si256(a, b)));
+		__m256i gg = first ? _mm256_xor_si256(_mm256_xor_si256(e, f), g)
+			: _mm256_or_si256(_mm256_and_si256(e, f), _mm256_andnot_si256(e, g));
+		__m256i tt1 = _mm256_add_epi32(_mm256_add_epi32(ff, d), _mm256_add_epi32(ss2, w2));
+		__m256i tt2 = _mm256_add_epi32(_mm256_add_epi32(gg, h), _mm256_add_epi32(ss1, w));
+		b = rotl_avx2<9>(b);
+		f = rotl_avx2<19>(f);
+		d = tt1;
+		h = p0_avx2(tt2);
+	}
+
+	template<bool first>
+	DIGESTPP_TARGET("avx2")
+	inline void rounds_avx2(__m256i* s, const __m256i* W, int t)
+	{
+		const uint32_t* K = constants<void>::K;
+		__m256i a = s[0], b = s[1], c = s[2], d = s[3], e = s[4], f = s[5], g = s[6], h = s[7];
+		for (int i = t; i < t + (first ? 16 : 48); i += 4)
+		{
+			round_avx2<first>(a, b, c, d, e, f, g, h, K[i], W[i], _mm256_xor_si256(W[i], W[i + 4]));
+			round_avx2<first>(d, a, b, c, h, e, f, g, K[i + 1], W[i + 1], _mm256_xor_si256(W[i + 1], W[i + 5]));
+			round_avx2<first>(c, d, a, b, g, h, e, f, K[i + 2], W[i + 2], _mm256_xor_si256(W[i + 2], W[i + 6]));
+			round_avx2<first>(b, c, d, a, f, g, h, e, K[i + 3], W[i + 3], _mm256_xor_si256(W[i + 3], W[i + 7]));
+		}
+		s[0] = a;
+		s[1] = b;
+		s[2] = c;
+		s[3] = d;
+		s[4] = e;
+		s[5] = f;
+		s[6] = g;
+		s[7] = h;
+	}
+
+	// Compress one block in each of 8 lanes
+	DIGESTPP_TARGET("avx2")
+	inline void transform_x8_avx2(uint32_t* state, const unsigned char* const* blocks)
+	{
+		__m256i W[68];
+		multi_buffer::load_words_avx2<true>(blocks, 0, W);
+		multi_buffer::load_words_avx2<true>(blocks, 32, W + 8);
+		for (int t = 16; t < 68; t++)
+		{
+			__m256i x = _mm256_xor_si256(_mm256_xor_si256(W[t - 16], W[t - 9]), rotl_avx2<15>(W[t - 3]));
+			W[t] = _mm256_xor_si256(_mm256_xor_si256(p1_avx2(x), rotl_avx2<7>(W[t - 13])), W[t - 6]);
+		}
+
+		__m256i S[8], R[8];
+		for (int i = 0; i < 8; i++)
+			R[i] = S[i] = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(state + i * 8));
+		rounds_avx2<true>(R, W, 0);
+		rounds_avx2<false>(R, W, 16);
+		for (int i = 0; i < 8; i++)
+			_mm256_storeu_si256(reinterpret_cast<__m256i*>(state + i * 8), _mm256_xor_si256(S[i], R[i]));
+	}
+#endif
+
+	// Expand one block into W[0..67] and W'[0..63].
+	// Returns false if no kernel is available on this CPU.
+	inline bool expand(const unsigned char* block, uint32_t* W, uint32_t* W2)
+	{
+#ifdef DIGESTPP_X86_SIMD
+		if (!cpu_features::get().ssse3)
+			return false;
+		expand_ssse3(block, W, W2);
+		return true;
+#else
+		(void)block;
+		(void)W;
+		(void)W2;
+		return false;
+#endif
+	}
+
+	struct sm3_batch_traits
+	{
+		static const size_t words = 8;
+		static const size_t digest_size = 32;
+		static const bool big_endian = true;
+		static const uint32_t* iv()
+		{
+			static const uint32_t H[8] = { 0x7380166f, 0x4914b2b9, 0x172442d7, 0xda8a0600,
+					0xa96f30bc, 0x163138aa, 0xe38dee4d, 0xb0fb0e4e };
+			return H;
+		}
+	};
+
+	// Compute SM3 of count messages with the multi-buffer kernel for this CPU.
+	// Returns false if there is none, in which case the caller hashes the messages one by one.
+	inline bool hash_batch(const unsigned char* const* data, const size_t* len, size_t count, unsigned char* out)
+	{
+#ifdef DIGESTPP_X86_SIMD
+		if (cpu_features::get().avx2)
+		{
+			multi_buffer::hash<8, sm3_batch_traits>(data, len, count, out, transform_x8_avx2);
+			return true;
+		}
+#else
+		(void)data;
+		(void)len;
+		(void)count;
+		(void)out;
+#endif
+		return false;
+	}
+
+} // namespace sm3_simd
+
+} // namespace detail
+
+} // namespace digestpp
+
+#endif // DIGESTPP_PROVIDERS_SM3_SIMD_HPP
@@ -0,0 +1,136 @@
+/*
+This code is written by kerukuro and released into public domain.
+*/
+
+#ifndef DIGESTPP_PROVIDERS_STREEBOG_SIMD_HPP
+#define DIGESTPP_PROVIDERS_STREEBOG_SIMD_HPP
+
+#include "../../../detail/cpu_features.hpp"
+#include "../constants/streebog_constants.hpp"
+#include <cstddef>
+#include <cstdint>
+
+namespace digestpp
+{
+
+namespace detail
+{
+
+namespace streebog_simd
+{
+	// Streebog compression function with AVX-512 VBMI and GFNI, without table lookups.
+	// The 512-bit state is kept byte-transposed (byte i of word w at position 8 * i + w). The S-box is applied
+	// to all 64 bytes with byte permutes, and the linear transformation L is split into 8x8 bit matrices:
+	// byte k of an output word is the sum over j of L[j][k] times byte j of the input word.
+	// GF2P8AFFINEQB multiplies every byte of a 64-bit lane by the matrix of that lane, so each input byte j
+	// is broadcast to all lanes (which also does the transposition P), and lane k gets matrix L[j][k].
+	template<typename T>
+	struct constants
+	{
+		// Matrices in the format of GF2P8AFFINEQB, indexed by input byte, then by output byte
+		const static uint64_t L[8][8];
+	};
+
+	template<typename T>
+	const uint64_t constants<T>::L[8][8] = {
+		{ 0x63c7ecba162c58b1ull, 0xae5c1682aa55ab57ull, 0x0205091120408001ull, 0x29538e3542850a14ull,
+		  0x65cbf28166cc9932ull, 0x9932fc6059b366ccull, 0x70e0b11357ae5cb8ull, 0x0c183d76e0c18306ull },
+		{ 0x3060f0d193264c98ull, 0x56ac0f49c58a152bull, 0xfffe03f80f1f3f7full, 0x122559a151a24489ull,
+		  0x254bb343a2448912ull, 0x050b132240800102ull, 0x43874cdbf4e8d0a1ull, 0x2a54832c72e5ca95ull },
+		{ 0xa85008b9dab56ad4ull, 0x9d3beb4a0913274eull, 0x18317aecc183060cull, 0x428548d3e4c89021ull,
+		  0x172e4a831122458bull, 0x2245a970c2840811ull, 0x3d7ac9af63c78f1eull, 0x9f3ee25b2953a74full },
+		{ 0x122559a151a24489ull, 0x4a94628f54a952a5ull, 0x102050b071e2c488ull, 0x3060f0d193264c98ull,
+		  0x0d1a397ef0e1c386ull, 0x82048b95a850a041ull, 0xc081c3464c983060ull, 0x75eba231172e5dbaull },
+		{ 0xb8705809ab57ae5cull, 0x274eba5282040913ull, 0x73e7bc0a67ce9c39ull, 0xdab5b0bbad5bb66dull,
+		  0x82048b95a850a041ull, 0x0d1a397ef0e1c386ull, 0x8912acd02851a244ull, 0x8103868c983060c0ull },
+		{ 0xd4a884dc6ddab56aull, 0xc386ce5f7cf8f0e1ull, 0x428548d3e4c89021ull, 0x18317aecc183060cull,
+		  0x4b96668744891225ull, 0x9224db25d9b264c9ull, 0x468c5ff9b468d1a3ull, 0x0a14234d90214285ull },
+		{ 0x0205091120408001ull, 0xd2a49ae71d3a74e9ull, 0x63c7ecba162c58b1ull, 0xb06172551b366cd8ull,
+		  0x0102040810204080ull, 0xe1c3672fbe7cf8f0ull, 0xba7551188b172e5dull, 0x0409172a50a04182ull },
+		{ 0x0c183d76e0c18306ull, 0x2347ad78d2a44891ull, 0x0409172a50a04182ull, 0xfaf510da4f9f3e7dull,
+		  0xc183c74e5cb870e0ull, 0x43874cdbf4e8d0a1ull, 0x050b132240800102ull, 0x63c7ecba162c58b1ull }
+	};
+
+#ifdef DIGESTPP_X86_SIMD
+	// Byte i of all words at lane i and back
+	DIGESTPP_TARGET("avx512f,avx512bw,avx512vl,avx512vbmi,gfni")
+	inline __m512i transpose(__m512i x)
+	{
+		const __m512i idx = _mm512_set_epi64(0x3f372f271f170f07ll, 0x3e362e261e160e06ll, 0x3d352d251d150d05ll,
+			0x3c342c241c140c04ll, 0x3b332b231b130b03ll, 0x3a322a221a120a02ll, 0x3931292119110901ll, 0x3830282018100800ll);
+		return _mm512_permutexvar_epi8(idx, x);
+	}
+
+	// Apply the S-box to every byte: two lookups in 128-byte halves of the table, selected by the top bit
+	DIGESTPP_TARGET("avx512f,avx512bw,avx512vl,avx512vbmi,gfni")
+	inline __m512i sub_bytes(__m512i x)
+	{
+		const unsigned char* S = streebog_constants<void>::S;
+		__m512i lo = _mm512_permutex2var_epi8(_mm512_loadu_si512(S), x, _mm512_loadu_si512(S + 64));
+		__m512i hi = _mm512_permutex2var_epi8(_mm512_loadu_si512(S + 128), x, _mm512_loadu_si512(S + 192));
+		return _mm512_mask_blend_epi8(_mm512_movepi8_mask(x), lo, hi);
+	}
+
+	// Byte j of every word, in all lanes, multiplied by the matrices of input byte j
+	template<int j>
+	DIGESTPP_TARGET("avx512f,avx512bw,avx512vl,avx512vbmi,gfni")
+	inline __m512i linear(__m512i x)
+	{
+		const __m512i idx = _mm512_set1_epi64(static_cast<long long>(0x3830282018100800ull + j * 0x0101010101010101ull));
+		return _mm512_gf2p8affine_epi64_epi8(_mm512_permutexvar_epi8(idx, x),
+			_mm512_loadu_si512(constants<void>::L[j]), 0);
+	}
+
+	DIGESTPP_TARGET("avx512f,avx512bw,avx512vl,avx512vbmi,gfni")
+	inline __m512i lps(__m512i x)
+	{
+		x = sub_bytes(x);
+		__m512i a = _mm512_xor_si512(linear<0>(x), linear<1>(x));
+		__m512i b = _mm512_xor_si512(linear<2>(x), linear<3>(x));
+		__m512i c = _mm512_xor_si512(linear<4>(x), linear<5>(x));
+		__m512i d = _mm512_xor_si512(linear<6>(x), linear<7>(x));
+		return _mm512_xor_si512(_mm512_xor_si512(a, b), _mm512_xor_si512(c, d));
+	}
+
+	DIGESTPP_TARGET("avx512f,avx512bw,avx512vl,avx512vbmi,gfni")
+	inline void gN_vbmi(uint64_t* h, const unsigned char* m, uint64_t N)
+	{
+		__m512i hv = _mm512_loadu_si512(h);
+		__m512i mv = transpose(_mm512_loadu_si512(m));
+		__m512i k = lps(transpose(_mm512_xor_si512(hv, _mm512_maskz_set1_epi64(1, static_cast<long long>(N)))));
+		__m512i s = _mm512_xor_si512(k, mv);
+		for (int i = 0; i < 12; i++)
+		{
+			s = lps(s);
+			k = lps(_mm512_xor_si512(k, transpose(_mm512_loadu_si512(streebog_constants<void>::RC[i]))));
+			s = _mm512_xor_si512(s, k);
+		}
+		_mm512_storeu_si512(h, _mm512_xor_si512(hv, transpose(_mm512_xor_si512(s, mv))));
+	}
+#endif
+
+	// Compress one block with the counter N.
+	// Returns false if no kernel is available on this CPU.
+	inline bool gN(uint64_t* h, const unsigned char* m, uint64_t N)
+	{
+#ifdef DIGESTPP_X86_SIMD
+		const cpu_features& cpu = cpu_features::get();
+		if (!cpu.vbmi || !cpu.gfni)
+			return false;
+		gN_vbmi(h, m, N);
+		return true;
+#else
+		(void)h;
+		(void)m;
+		(void)N;
+		return false;
+#endif
+	}
+
+} // namespace streebog_simd
+
+} // namespace detail
+
+} // namespace digestpp
+
+#endif // DIGESTPP_PROVIDERS_STREEBOG_SIMD_HPP
@@ -7,9 +7,13 @@ This code is written by kerukuro and released into public domain.
 
 #include "../../detail/functions.hpp"
 #include "../../detail/absorb_data.hpp"
+#include "../../detail/parallel_for.hpp"
 #include "../../detail/validate_hash_size.hpp"
 #include "constants/skein_constants.hpp"
+#include "simd/skein_simd.hpp"
+#include <algorithm>
 #include <array>
+#include <vector>
 
 namespace digestpp
 {
@@ -182,17 +186,18 @@ class skein_provider
 {
 public:
 	static const bool is_xof = XOF;
+	static const size_t static_hash_size = HS;
 
 	template<size_t hss=HS, typename std::enable_if<hss == 0>::type* = nullptr>
 	skein_provider(size_t hashsize = N)
-		: hs(hashsize)
+		: hs(hashsize), tree_leaf(0), tree_fan(0), tree_height(0), threads(1), min_parallel(1024 * 1024)
 	{
 		validate_hash_size(hashsize, SIZE_MAX);
 	}
 
 	template<size_t hss=HS, typename std::enable_if<hss != 0>::type* = nullptr>
 	skein_provider(size_t hashsize = N)
-		: hs(hss)
+		: hs(hss), tree_leaf(0), tree_fan(0), tree_height(0), threads(1), min_parallel(1024 * 1024)
 	{
 		static_assert(hss > 0 && hss % 8 == 0);
 	}
@@ -217,6 +222,22 @@ public:
 		k = key;
 	}
 
+	inline void set_tree(uint8_t leaf, uint8_t fan_out, uint8_t max_height)
+	{
+		if ((leaf || fan_out || max_height) && (leaf < 1 || leaf > 24 || fan_out < 1 || fan_out > 24 || max_height < 2))
+			throw std::runtime_error("invalid tree parameters");
+
+		tree_leaf = leaf;
+		tree_fan = fan_out;
+		tree_height = max_height;
+	}
+
+	inline void set_threads(size_t thread_count, size_t min_size)
+	{
+		threads = thread_count;
+		min_parallel = min_size;
+	}
+
 	inline void init()
 	{
 		squeezing = false;
@@ -234,6 +255,9 @@ public:
 		m[4] = 0x01;
 		uint64_t size64 = XOF ? static_cast<uint64_t>(-1) : hs;
 		memcpy(&m[8], &size64, 8);
+		m[16] = tree_leaf;
+		m[17] = tree_fan;
+		m[18] = tree_height;
 		transform(m.data(), 1, 32);
 		pos = 0;
 		total = 0;
@@ -242,12 +266,21 @@ public:
 		inject_parameter(p, 8ULL);
 		inject_parameter(n, 20ULL);
 
+		if (tree_height)
+		{
+			tree_key = H;
+			levels.clear();
+			leaf_index = 0;
+			start_leaf();
+		}
 	}
 
 	inline void update(const unsigned char* data, size_t len)
 	{
-		detail::absorb_bytes(data, len, N / 8, N / 8 + 1, m.data(), pos, total,
-			[this](const unsigned char* data, size_t len) { transform(data, len, N / 8); });
+		if (tree_height)
+			update_tree(data, len);
+		else
+			absorb(data, len);
 	}
 
 	inline void squeeze(unsigned char* hash, size_t hs)
@@ -256,11 +289,16 @@ public:
 		if (!squeezing)
 		{
 			squeezing = true;
-			tweak[1] |= 1ull << 63; // last block
-			if (pos < N / 8)
-				memset(&m[pos], 0, N / 8 - pos);
+			if (tree_height)
+				finalize_tree();
+			else
+			{
+				tweak[1] |= 1ull << 63; // last block
+				if (pos < N / 8)
+					memset(&m[pos], 0, N / 8 - pos);
 
-			transform(m.data(), 1, pos);
+				transform(m.data(), 1, pos);
+			}
 			memset(&m[0], 0, N / 8);
 			memcpy(&hbk[0], H.data(), N / 8);
 			pos = 0;
@@ -309,11 +347,206 @@ public:
 		p.clear();
 		n.clear();
 		k.clear();
+		zero_memory(tree_key);
+		for (auto& level : levels)
+			level.clear();
+		levels.clear();
+		tree_leaf = 0;
+		tree_fan = 0;
+		tree_height = 0;
 	}
 
 private:
+	// Chaining state of a tree node being hashed
+	struct tree_node
+	{
+		std::array<uint64_t, N / 64> H;
+		std::array<uint64_t, 2> tweak;
+		std::array<unsigned char, N / 8> last; // last chaining value received, processed when the next one arrives
+		uint64_t count; // chaining values received at this level
+		uint64_t node_count; // chaining values received for the current node
+
+		void clear()
+		{
+			zero_memory(H);
+			zero_memory(last);
+		}
+	};
+
+	inline void absorb(const unsigned char* data, size_t len)
+	{
+		detail::absorb_bytes(data, len, N / 8, N / 8 + 1, m.data(), pos, total,
+			[this](const unsigned char* data, size_t len) { transform(data, len, N / 8); });
+	}
+
+	// Tree mode: the message is split into leaves of N / 8 * 2^tree_leaf bytes, hashed with UBI at level 1.
+	// The last block of the current leaf is kept in m until more data arrives, as it must be processed as the final block.
+	inline void update_tree(const unsigned char* data, size_t len)
+	{
+		const size_t leaf_size = (N / 8) << tree_leaf;
+		while (len)
+		{
+			if (leaf_len == leaf_size)
+			{
+				finish_leaf();
+				start_leaf();
+			}
+			if (!leaf_len && len > leaf_size)
+			{
+				// Leaves followed by more data are complete and can be hashed independently
+				size_t count = (len - 1) / leaf_size;
+				hash_leaves(data, count);
+				data += count * leaf_size;
+				len -= count * leaf_size;
+				start_leaf();
+			}
+			size_t chunk = std::min(len, leaf_size - leaf_len);
+			absorb(data, chunk);
+			leaf_len += chunk;
+			data += chunk;
+			len -= chunk;
+		}
+	}
+
+	inline void start_leaf()
+	{
+		H = tree_key;
+		tweak[0] = leaf_index * ((N / 8) << tree_leaf);
+		tweak[1] = (1ULL << 62) | (48ULL << 56) | (1ULL << 48);
+		pos = 0;
+		leaf_len = 0;
+	}
+
+	inline void finish_leaf()
+	{
+		tweak[1] |= 1ull << 63; // last block
+		if (pos < N / 8)
+			memset(&m[pos], 0, N / 8 - pos);
+		transform(m.data(), 1, pos);
+		leaf_index++;
+		add_to_tree(1, reinterpret_cast<const unsigned char*>(H.data()));
+	}
+
+	// Hash complete leaves; large inputs are split between threads.
+	// Chaining values are collected in batches of 16 leaves per thread (or 64 KiB of chaining values if larger),
+	// so the buffer does not grow with the input.
+	inline void hash_leaves(const unsigned char* data, size_t count)
+	{
+		const size_t leaf_size = (N / 8) << tree_leaf;
+		const size_t use_threads = count * leaf_size < min_parallel ? 1 : threads;
+		const size_t batch = std::min(count, std::max(threads * 16, size_t(64 * 1024) / (N / 8)));
+		leaf_cv.resize(batch * (N / 8));
+		unsigned char* cv = leaf_cv.data();
+		while (count)
+		{
+			size_t leaves = std::min(count, batch);
+			uint64_t first = leaf_index;
+			parallel_for(leaves, 1, use_threads, [this, data, first, leaf_size, cv](size_t begin, size_t end)
+			{
+				for (size_t i = begin; i < end; i++)
+					hash_leaf(first + i, data + i * leaf_size, cv + i * (N / 8));
+			});
+
+			for (size_t i = 0; i < leaves; i++)
+				add_to_tree(1, cv + i * (N / 8));
+			leaf_index += leaves;
+			data += leaves * leaf_size;
+			count -= leaves;
+		}
+		zero_memory(leaf_cv.data(), leaf_cv.size());
+	}
+
+	inline void hash_leaf(uint64_t index, const unsigned char* data, unsigned char* cv) const
+	{
+		const size_t blocks = size_t(1) << tree_leaf;
+		std::array<uint64_t, N / 64> state = tree_key;
+		std::array<uint64_t, 2> t = { { index * blocks * (N / 8), (1ULL << 62) | (48ULL << 56) | (1ULL << 48) } };
+		compress(state, t, data, blocks - 1, N / 8);
+		t[1] |= 1ull << 63; // last block
+		compress(state, t, data + (blocks - 1) * (N / 8), 1, N / 8);
+		memcpy(cv, state.data(), N / 8);
+		zero_memory(state);
+	}
+
+	// Add a chaining value computed at the given level to the node of the next level.
+	// Nodes of 2^tree_fan values are hashed as soon as they are complete; at the maximum height
+	// all values are hashed as a single node.
+	inline void add_to_tree(size_t level, const unsigned char* cv)
+	{
+		if (levels.size() < level)
+		{
+			levels.emplace_back();
+			levels.back().count = 0;
+			levels.back().node_count = 0;
+		}
+		tree_node& node = levels[level - 1];
+		if (!node.node_count)
+		{
+			node.H = tree_key;
+			node.tweak[0] = node.count * (N / 8);
+			node.tweak[1] = (1ULL << 62) | (48ULL << 56) | (static_cast<uint64_t>(level + 1) << 48);
+		}
+		else
+			compress(node.H, node.tweak, node.last.data(), 1, N / 8);
+		memcpy(node.last.data(), cv, N / 8);
+		node.count++;
+		node.node_count++;
+		if (level + 1 < tree_height && node.node_count == (uint64_t(1) << tree_fan))
+		{
+			std::array<unsigned char, N / 8> result;
+			finish_node(node, result.data());
+			add_to_tree(level + 1, result.data());
+			zero_memory(result);
+		}
+	}
+
+	inline void finish_node(tree_node& node, unsigned char* result)
+	{
+		node.tweak[1] |= 1ull << 63; // last block
+		compress(node.H, node.tweak, node.last.data(), 1, N / 8);
+		memcpy(result, node.H.data(), N / 8);
+		node.node_count = 0;
+	}
+
+	// Process the last leaf and the remaining nodes of each level; the root result is left in H
+	inline void finalize_tree()
+	{
+		finish_leaf();
+		std::array<unsigned char, N / 8> result;
+		for (size_t level = 1; ; level++)
+		{
+			tree_node& node = levels[level - 1];
+			if (node.count == 1)
+			{
+				memcpy(H.data(), node.last.data(), N / 8);
+				break;
+			}
+			if (level + 1 == tree_height)
+			{
+				finish_node(node, result.data());
+				memcpy(H.data(), result.data(), N / 8);
+				break;
+			}
+			if (node.node_count)
+			{
+				finish_node(node, result.data());
+				add_to_tree(level + 1, result.data());
+			}
+		}
+		zero_memory(result);
+	}
+
 	inline void transform(const unsigned char* mp, uint64_t num_blks, size_t reallen)
 	{
+		compress(H, tweak, mp, num_blks, reallen);
+	}
+
+	static inline void compress(std::array<uint64_t, N / 64>& H, std::array<uint64_t, 2>& tweak,
+			const unsigned char* mp, uint64_t num_blks, size_t reallen)
+	{
+		if (skein_simd::transform<N / 64>(H.data(), tweak.data(), mp, num_blks, reallen))
+			return;
+
 		uint64_t keys[N / 64 + 1];
 		uint64_t tweaks[3];
 
@@ -365,7 +598,7 @@ private:
 			return;
 
 		tweak[1] = (1ULL << 62) | (code << 56);
-		update(reinterpret_cast<const unsigned char*>(p.data()), p.length());
+		absorb(reinterpret_cast<const unsigned char*>(p.data()), p.length());
 		tweak[1] |= 1ull << 63; // last block
 		if (pos < N / 8)
 			memset(&m[pos], 0, N / 8 - pos);
@@ -385,6 +618,16 @@ private:
 	size_t hs;
 	bool squeezing;
 	std::string p, n, k;
+	uint8_t tree_leaf;
+	uint8_t tree_fan;
+	uint8_t tree_height;
+	std::array<uint64_t, N / 64> tree_key;
+	std::vector<tree_node> levels;
+	std::vector<unsigned char> leaf_cv;
+	uint64_t leaf_index;
+	size_t leaf_len;
+	size_t threads;
+	size_t min_parallel;
 };
 
 
@@ -7,6 +7,7 @@ This code is written by kerukuro and released into public domain.
 
 #include "../../detail/functions.hpp"
 #include "../../detail/absorb_data.hpp"
+#include "simd/sm3_simd.hpp"
 #include <array>
 
 namespace digestpp
@@ -47,6 +48,8 @@ class sm3_provider
 {
 public:
 	static const bool is_xof = false;
+	static const size_t static_hash_size = 256;
+	static const size_t max_hash_size = 256;
 
 	sm3_provider()
 	{
@@ -110,18 +113,17 @@ private:
 	{
 		for (uint64_t blk = 0; blk < num_blks; blk++)
 		{
-			uint32_t M[16];
-			for (uint32_t i = 0; i < 64 / 4; i++)
-				M[i] = byteswap(reinterpret_cast<const uint32_t*>(data)[blk * 16 + i]);
-
 			uint32_t W[68];
 			uint32_t W2[64];
-			for (int t = 0; t <= 15; t++)
-				W[t] = M[t];
-			for (int t = 16; t <= 67; t++)
-				W[t] = sm3_functions::p1(W[t - 16] ^ W[t - 9] ^ rotate_left(W[t - 3], 15)) ^ rotate_left(W[t - 13], 7) ^ W[t - 6];
-			for (int t = 0; t <= 63; t++)
-				W2[t] = W[t] ^ W[t + 4];
+			if (!sm3_simd::expand(data + blk * 64, W, W2))
+			{
+				for (uint32_t i = 0; i < 64 / 4; i++)
+					W[i] = byteswap(reinterpret_cast<const uint32_t*>(data)[blk * 16 + i]);
+				for (int t = 16; t <= 67; t++)
+					W[t] = sm3_functions::p1(W[t - 16] ^ W[t - 9] ^ rotate_left(W[t - 3], 15)) ^ rotate_left(W[t - 13], 7) ^ W[t - 6];
+				for (int t = 0; t <= 63; t++)
+					W2[t] = W[t] ^ W[t + 4];
+			}
 
 			uint32_t a = H[0];
 			uint32_t b = H[1];
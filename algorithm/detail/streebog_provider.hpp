@@ -9,6 +9,7 @@ This code is written by kerukuro and released into public domain.
 #include "../../detail/absorb_data.hpp"
 #include "../../detail/validate_hash_size.hpp"
 #include "constants/streebog_constants.hpp"
+#include "simd/streebog_simd.hpp"
 #include <array>
 
 namespace digestpp
@@ -87,14 +88,25 @@ namespace streebog_functions
 	static inline void addm(const unsigned char* m, uint64_t* h)
 	{
 		const uint64_t* m64 = reinterpret_cast<const uint64_t*>(m);
-		bool carry = false, overflow = false;
+#if defined(DIGESTPP_X86_SIMD) && (defined(__x86_64__) || defined(_M_X64))
+		// Add with carry instructions
+		unsigned char carry = 0;
+		for (int i = 0; i < 8; i++)
+		{
+			unsigned long long t;
+			carry = _addcarry_u64(carry, h[i], m64[i], &t);
+			h[i] = t;
+		}
+#else
+		uint64_t carry = 0;
 		for (int i = 0; i < 8; i++)
 		{
 			uint64_t t = h[i] + m64[i];
-			overflow = t < h[i] || t < m64[i];
+			uint64_t overflow = t < m64[i];
 			h[i] = t + carry;
-			carry = overflow;
+			carry = overflow | (h[i] < t);
 		}
+#endif
 	}
 
 }
@@ -104,6 +116,8 @@ class streebog_provider
 {
 public:
 	static const bool is_xof = false;
+	static const size_t static_hash_size = HS;
+	static const size_t max_hash_size = 512;
 
 	template<size_t hss=HS, typename std::enable_if<hss == 0>::type* = nullptr>
 	streebog_provider(size_t hashsize)
@@ -168,7 +182,9 @@ private:
 	{
 		for (size_t blk = 0; blk < num_blks; blk++)
 		{
-			streebog_functions::gN(&h[0], mp + blk * 64, final ? 0ULL : total + blk * 512);
+			uint64_t N = final ? 0ULL : total + blk * 512;
+			if (!streebog_simd::gN(&h[0], mp + blk * 64, N))
+				streebog_functions::gN(&h[0], mp + blk * 64, N);
 
 			if (!final)
 				streebog_functions::addm(mp + blk * 64, &S[0]);
@@ -36,6 +36,8 @@ class whirlpool_provider
 {
 public:
 	static const bool is_xof = false;
+	static const size_t static_hash_size = 512;
+	static const size_t max_hash_size = 512;
 
 	whirlpool_provider()
 	{
@@ -7,6 +7,7 @@ This code is written by kerukuro and released into public domain.
 
 #include "../hasher.hpp"
 #include "detail/md5_provider.hpp"
+#include "detail/simd/md5_simd.hpp"
 
 namespace digestpp
 {
@@ -55,6 +56,44 @@ namespace digestpp
  */
 typedef hasher<detail::md5_provider> md5;
 
+/**
+ * @brief Compute MD5 digests of many independent messages
+ *
+ * Messages are hashed in parallel, one per SIMD lane (8 lanes with AVX2, 16 with AVX-512).
+ * A lane that finishes its message continues with the next one, so the messages can have different lengths.
+ * Without SIMD support the messages are hashed one by one.
+ *
+ * @warning See the warning for md5; this is only useful for non-security purposes such as checksums and ETags.
+ *
+ * @param[in] data Pointers to the messages
+ * @param[in] len Lengths of the messages (in bytes)
+ * @param[in] count Number of messages
+ * @param[out] out Output buffer for count * 16 bytes; the digest of message i is written to out + i * 16
+ *
+ * @par Example:
+ * @code // Output MD5 digests of two strings
+ * const char* msg[] = { "abc", "The quick brown fox jumps over the lazy dog" };
+ * const unsigned char* data[] = { reinterpret_cast<const unsigned char*>(msg[0]), reinterpret_cast<const unsigned char*>(msg[1]) };
+ * size_t len[] = { strlen(msg[0]), strlen(msg[1]) };
+ * unsigned char out[2 * 16];
+ * digestpp::md5_batch(data, len, 2, out);
+ * @endcode
+ *
+ * @sa md5
+ */
+inline void md5_batch(const unsigned char* const* data, const size_t* len, size_t count, unsigned char* out)
+{
+	if (detail::md5_simd::hash_batch(data, len, count, out))
+		return;
+	detail::md5_provider provider;
+	for (size_t i = 0; i < count; i++)
+	{
+		provider.init();
+		provider.update(data[i], len[i]);
+		provider.final(out + i * 16);
+	}
+}
+
 /** @} */ // End of MD5 group
 
 } // namespace digestpp
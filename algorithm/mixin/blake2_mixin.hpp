@@ -117,6 +117,59 @@ public:
 	{
 		return set_key(std::string(reinterpret_cast<const char*>(key), key_len));
 	}
+
+	/**
+	 * \brief Write output bytes starting at the given offset
+	 *
+	 * Each block of BLAKE2X output is computed independently from the root hash,
+	 * so any part of the output can be obtained without computing the preceding bytes.
+	 * The result is the same as bytes [offset, offset + len) of the digest (or of the squeezed output for XOF).
+	 * The state of the hasher is not changed.
+	 *
+	 * \available_if Algorithm is BLAKE2X (blake2xb, blake2xs, blake2xb_xof, blake2xs_xof)
+	 *
+	 * \param[in] offset Offset of the first byte (in bytes)
+	 * \param[out] buf Buffer to write data to; must be of byte type (char, unsigned char or signed char)
+	 * \param[in] len Size of data to write (in bytes)
+	 * \throw std::runtime_error if the range exceeds the digest size of BLAKE2X with fixed output size.
+	 *
+	 * @par Example:
+	 * @code // Get the second megabyte of output
+	 * digestpp::blake2xb_xof hasher;
+	 * hasher.absorb("seed");
+	 * std::vector<unsigned char> part(1024 * 1024);
+	 * hasher.squeeze_at(1024 * 1024, part.data(), part.size());
+	 * @endcode
+	 */
+	template<typename C, typename H = T,
+		typename std::enable_if<detail::is_byte<C>::value && detail::is_blake2x<H>::value>::type* = nullptr>
+	inline void squeeze_at(uint64_t offset, C* buf, size_t len) const
+	{
+		const auto& blake = static_cast<const hasher<T, mixin::blake2_mixin>&>(*this);
+		blake.provider.squeeze_at(offset, reinterpret_cast<unsigned char*>(buf), len);
+	}
+
+	/**
+	 * \brief Compute output with several threads
+	 *
+	 * Blocks of BLAKE2X output are independent, so they can be computed in parallel.
+	 * Threads are started when a single request for output (squeeze, squeeze_at or digest)
+	 * covers at least min_size bytes, otherwise the output is computed by the calling thread.
+	 * Output does not depend on these settings. By default only the calling thread is used.
+	 *
+	 * \available_if Algorithm is BLAKE2X (blake2xb, blake2xs, blake2xb_xof, blake2xs_xof)
+	 *
+	 * \param[in] threads Maximum number of threads (including the calling thread)
+	 * \param[in] min_size Minimum amount of output (in bytes) to use threads for
+	 * \return Reference to hasher
+	 */
+	template<typename H = T, typename std::enable_if<detail::is_blake2x<H>::value>::type* = nullptr>
+	inline hasher<T, mixin::blake2_mixin>& set_threads(size_t threads, size_t min_size = 1024 * 1024)
+	{
+		auto& blake = static_cast<hasher<T, mixin::blake2_mixin>&>(*this);
+		blake.provider.set_threads(threads, min_size);
+		return blake;
+	}
 };
 
 
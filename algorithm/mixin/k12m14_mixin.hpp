@@ -46,6 +46,25 @@ public:
 	{
 		return set_customization(std::string(reinterpret_cast<const char*>(customization), customization_len));
 	}
+
+	/**
+	 * \brief Hash leaves with several threads
+	 *
+	 * Leaves of the hash tree are independent, so they can be hashed in parallel.
+	 * Threads are started when a single call to absorb() provides at least min_size bytes of complete leaves,
+	 * otherwise the data is hashed by the calling thread. Output does not depend on these settings.
+	 * By default only the calling thread is used.
+	 *
+	 * \param[in] threads Maximum number of threads (including the calling thread)
+	 * \param[in] min_size Minimum amount of data (in bytes) to use threads for
+	 * \return Reference to hasher
+	 */
+	inline hasher<T, mixin::k12m14_mixin>& set_threads(size_t threads, size_t min_size = 1024 * 1024)
+	{
+		auto& k12m14 = static_cast<hasher<T, mixin::k12m14_mixin>&>(*this);
+		k12m14.provider.set_threads(threads, min_size);
+		return k12m14;
+	}
 };
 
 } // namespace mixin
@@ -99,6 +99,56 @@ public:
 	{
 		return set_nonce(std::string(reinterpret_cast<const char*>(nonce), nonce_len));
 	}
+
+	/**
+	 * \brief Enable tree hashing mode
+	 *
+	 * The message is split into leaves of 2^leaf blocks, which are hashed independently,
+	 * and the resulting chaining values are combined in nodes of 2^fan_out values,
+	 * up to the maximum tree height. Leaves can be hashed in parallel (see set_threads).
+	 * The result differs from the result of sequential hashing. Passing zero for all
+	 * parameters restores sequential hashing.
+	 *
+	 * \param[in] leaf Leaf size parameter Y_l (1-24)
+	 * \param[in] fan_out Fan-out parameter Y_f (1-24)
+	 * \param[in] max_height Maximum tree height Y_m (2-255)
+	 * \return Reference to hasher
+	 * \throw std::runtime_error if the parameters are out of range.
+	 *
+	 * @par Example:
+	 * @code // Hash a file with 256 KiB leaves using 4 threads
+	 * digestpp::skein512 hasher(512);
+	 * hasher.set_tree(12, 2, 255).set_threads(4);
+	 * std::ifstream file("file", std::ios_base::in | std::ios_base::binary);
+	 * std::cout << hasher.absorb(file).hexdigest() << '\n';
+	 * @endcode
+	 */
+	inline hasher<T, mixin::skein_mixin>& set_tree(uint8_t leaf, uint8_t fan_out, uint8_t max_height)
+	{
+		auto& skein = static_cast<hasher<T, mixin::skein_mixin>&>(*this);
+		skein.provider.set_tree(leaf, fan_out, max_height);
+		skein.provider.init();
+		return skein;
+	}
+
+	/**
+	 * \brief Hash tree leaves with several threads
+	 *
+	 * Threads are started when a single call to absorb contains at least min_size bytes
+	 * of complete leaves, otherwise the leaves are hashed by the calling thread.
+	 * Output does not depend on these settings. By default only the calling thread is used.
+	 * Has no effect unless tree hashing is enabled with set_tree.
+	 *
+	 * \param[in] threads Maximum number of threads (including the calling thread)
+	 * \param[in] min_size Minimum amount of data (in bytes) to use threads for
+	 * \return Reference to hasher
+	 */
+	inline hasher<T, mixin::skein_mixin>& set_threads(size_t threads, size_t min_size = 1024 * 1024)
+	{
+		auto& skein = static_cast<hasher<T, mixin::skein_mixin>&>(*this);
+		skein.provider.set_threads(threads, min_size);
+		return skein;
+	}
 };
 
 } // namespace mixin
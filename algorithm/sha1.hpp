@@ -48,6 +48,42 @@ namespace digestpp
  */
 typedef hasher<detail::sha1_provider> sha1;
 
+/**
+ * @brief Compute SHA-1 digests of many independent messages
+ *
+ * Messages are hashed in parallel, one per SIMD lane (8 lanes with AVX2, 16 with AVX-512).
+ * A lane that finishes its message continues with the next one, so the messages can have different lengths.
+ * Without SIMD support, or with SHA extensions and no AVX-512, the messages are hashed one by one.
+ *
+ * @param[in] data Pointers to the messages
+ * @param[in] len Lengths of the messages (in bytes)
+ * @param[in] count Number of messages
+ * @param[out] out Output buffer for count * 20 bytes; the digest of message i is written to out + i * 20
+ *
+ * @par Example:
+ * @code // Output SHA-1 digests of two strings
+ * const char* msg[] = { "abc", "The quick brown fox jumps over the lazy dog" };
+ * const unsigned char* data[] = { reinterpret_cast<const unsigned char*>(msg[0]), reinterpret_cast<const unsigned char*>(msg[1]) };
+ * size_t len[] = { strlen(msg[0]), strlen(msg[1]) };
+ * unsigned char out[2 * 20];
+ * digestpp::sha1_batch(data, len, 2, out);
+ * @endcode
+ *
+ * @sa sha1
+ */
+inline void sha1_batch(const unsigned char* const* data, const size_t* len, size_t count, unsigned char* out)
+{
+	if (detail::sha1_simd::hash_batch(data, len, count, out))
+		return;
+	detail::sha1_provider provider;
+	for (size_t i = 0; i < count; i++)
+	{
+		provider.init();
+		provider.update(data[i], len[i]);
+		provider.final(out + i * 20);
+	}
+}
+
 /** @} */ // End of SHA1 group
 
 } // namespace digestpp
@@ -7,6 +7,7 @@ This code is written by kerukuro and released into public domain.
 
 #include "../hasher.hpp"
 #include "detail/sha3_provider.hpp"
+#include "detail/simd/sha3_simd.hpp"
 
 namespace digestpp
 {
@@ -54,6 +55,48 @@ namespace digestpp
  */
 typedef hasher<detail::sha3_provider<>> sha3;
 
+/**
+ * @brief Compute SHA-3 digests of many independent messages
+ *
+ * Messages are hashed in parallel, one per SIMD lane (4 lanes with AVX2, 8 with AVX-512).
+ * A lane that finishes its message continues with the next one, so the messages can have different lengths.
+ * Without SIMD support the messages are hashed one by one.
+ *
+ * @param[in] data Pointers to the messages
+ * @param[in] len Lengths of the messages (in bytes)
+ * @param[in] count Number of messages
+ * @param[out] out Output buffer for count * hashsize / 8 bytes; the digest of message i is written to out + i * hashsize / 8
+ * @param[in] hashsize Digest size in bits (224, 256, 384 or 512)
+ *
+ * @throw std::runtime_error if the requested digest size is not supported
+ *
+ * @par Example:
+ * @code // Compute SHA3-256 digests of commitments
+ * std::vector<const unsigned char*> data = ...;
+ * std::vector<size_t> len = ...;
+ * std::vector<unsigned char> out(data.size() * 32);
+ * digestpp::sha3_batch(data.data(), len.data(), data.size(), out.data(), 256);
+ * @endcode
+ *
+ * @sa sha3, shake128_batch, shake256_batch
+ */
+inline void sha3_batch(const unsigned char* const* data, const size_t* len, size_t count, unsigned char* out, size_t hashsize)
+{
+	detail::sha3_provider<> provider(hashsize);
+	size_t lanes = detail::sha3_simd::lanes();
+	if (lanes > 1)
+	{
+		detail::sha3_simd::hash_batch<24>(lanes, data, len, count, out, hashsize / 8, 200 - hashsize / 4, 0x06);
+		return;
+	}
+	for (size_t i = 0; i < count; i++)
+	{
+		provider.init();
+		provider.update(data[i], len[i]);
+		provider.final(out + i * hashsize / 8);
+	}
+}
+
 /** @} */ // End of SHA3 group
 
 namespace static_size
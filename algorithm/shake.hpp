@@ -7,6 +7,7 @@ This code is written by kerukuro and released into public domain.
 
 #include "../hasher.hpp"
 #include "detail/shake_provider.hpp"
+#include "detail/simd/sha3_simd.hpp"
 #include "mixin/cshake_mixin.hpp"
 
 namespace digestpp
@@ -50,6 +51,38 @@ namespace digestpp
  */
 typedef hasher<detail::shake_provider<128, 24>> shake128;
 
+/**
+ * @brief Compute SHAKE128 output for many independent messages
+ *
+ * Messages are hashed in parallel, one per SIMD lane (4 lanes with AVX2, 8 with AVX-512).
+ * A lane that finishes its message continues with the next one, so the messages can have different lengths.
+ * Without SIMD support the messages are hashed one by one.
+ *
+ * @param[in] data Pointers to the messages
+ * @param[in] len Lengths of the messages (in bytes)
+ * @param[in] count Number of messages
+ * @param[out] out Output buffer for count * out_len bytes; the output for message i is written to out + i * out_len
+ * @param[in] out_len Output length per message (in bytes)
+ *
+ * @sa shake128, sha3_batch
+ */
+inline void shake128_batch(const unsigned char* const* data, const size_t* len, size_t count, unsigned char* out, size_t out_len)
+{
+	size_t lanes = detail::sha3_simd::lanes();
+	if (lanes > 1)
+	{
+		detail::sha3_simd::hash_batch<24>(lanes, data, len, count, out, out_len, 168, 0x1F);
+		return;
+	}
+	detail::shake_provider<128, 24> provider;
+	for (size_t i = 0; i < count; i++)
+	{
+		provider.init();
+		provider.update(data[i], len[i]);
+		provider.squeeze(out + i * out_len, out_len);
+	}
+}
+
 /**
  * @brief SHAKE256 extendable output function
  * 
@@ -81,6 +114,38 @@ typedef hasher<detail::shake_provider<128, 24>> shake128;
  */
 typedef hasher<detail::shake_provider<256, 24>> shake256;
 
+/**
+ * @brief Compute SHAKE256 output for many independent messages
+ *
+ * Messages are hashed in parallel, one per SIMD lane (4 lanes with AVX2, 8 with AVX-512).
+ * A lane that finishes its message continues with the next one, so the messages can have different lengths.
+ * Without SIMD support the messages are hashed one by one.
+ *
+ * @param[in] data Pointers to the messages
+ * @param[in] len Lengths of the messages (in bytes)
+ * @param[in] count Number of messages
+ * @param[out] out Output buffer for count * out_len bytes; the output for message i is written to out + i * out_len
+ * @param[in] out_len Output length per message (in bytes)
+ *
+ * @sa shake256, sha3_batch
+ */
+inline void shake256_batch(const unsigned char* const* data, const size_t* len, size_t count, unsigned char* out, size_t out_len)
+{
+	size_t lanes = detail::sha3_simd::lanes();
+	if (lanes > 1)
+	{
+		detail::sha3_simd::hash_batch<24>(lanes, data, len, count, out, out_len, 136, 0x1F);
+		return;
+	}
+	detail::shake_provider<256, 24> provider;
+	for (size_t i = 0; i < count; i++)
+	{
+		provider.init();
+		provider.update(data[i], len[i]);
+		provider.squeeze(out + i * out_len, out_len);
+	}
+}
+
 /**
  * @brief cSHAKE128 customizable extendable output function
  *
@@ -55,6 +55,42 @@ namespace digestpp
  */
 typedef hasher<detail::sm3_provider> sm3;
 
+/**
+ * @brief Compute SM3 digests of many independent messages
+ *
+ * Messages are hashed in parallel, one per SIMD lane (8 lanes with AVX2).
+ * A lane that finishes its message continues with the next one, so the messages can have different lengths.
+ * Without SIMD support the messages are hashed one by one.
+ *
+ * @param[in] data Pointers to the messages
+ * @param[in] len Lengths of the messages (in bytes)
+ * @param[in] count Number of messages
+ * @param[out] out Output buffer for count * 32 bytes; the digest of message i is written to out + i * 32
+ *
+ * @par Example:
+ * @code // Output SM3 digests of two strings
+ * const char* msg[] = { "abc", "The quick brown fox jumps over the lazy dog" };
+ * const unsigned char* data[] = { reinterpret_cast<const unsigned char*>(msg[0]), reinterpret_cast<const unsigned char*>(msg[1]) };
+ * size_t len[] = { strlen(msg[0]), strlen(msg[1]) };
+ * unsigned char out[2 * 32];
+ * digestpp::sm3_batch(data, len, 2, out);
+ * @endcode
+ *
+ * @sa sm3, sha256_batch
+ */
+inline void sm3_batch(const unsigned char* const* data, const size_t* len, size_t count, unsigned char* out)
+{
+	if (detail::sm3_simd::hash_batch(data, len, count, out))
+		return;
+	detail::sm3_provider provider;
+	for (size_t i = 0; i < count; i++)
+	{
+		provider.init();
+		provider.update(data[i], len[i]);
+		provider.final(out + i * 32);
+	}
+}
+
 /** @} */ // End of SM3 group
 
 } // namespace digestpp
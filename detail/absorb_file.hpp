@@ -0,0 +1,176 @@
+/*
+This code is written by kerukuro and released into public domain.
+*/
+
+#ifndef DIGESTPP_DETAIL_ABSORB_FILE_HPP
+#define DIGESTPP_DETAIL_ABSORB_FILE_HPP
+
+#include <algorithm>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#if defined(__unix__) || defined(__APPLE__)
+#define DIGESTPP_POSIX_FILES
+#include <cerrno>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#else
+#include <fstream>
+#endif
+
+namespace digestpp
+{
+namespace detail
+{
+
+#ifdef DIGESTPP_POSIX_FILES
+
+namespace file_functions
+{
+	// Regular files are mapped in windows of this size, so that address space use is bounded on any platform
+	const size_t map_window = 64 * 1024 * 1024;
+	// Pages behind the cursor are released after each step, keeping resident memory flat
+	const size_t map_step = 4 * 1024 * 1024;
+	// Buffer size for files that can't be mapped
+	const size_t read_chunk = 1024 * 1024;
+
+	// Map the file from offset to size and feed the mapped pages to update().
+	// Returns the offset up to which the data was absorbed, which is less than size if mapping failed.
+	template<typename F>
+	inline off_t map_file(int fd, off_t offset, off_t size, bool huge_pages, F& update)
+	{
+		const off_t page = static_cast<off_t>(sysconf(_SC_PAGESIZE));
+		while (offset < size)
+		{
+			off_t start = offset - offset % page;
+			size_t skew = static_cast<size_t>(offset - start);
+			size_t len = static_cast<size_t>(std::min<off_t>(size - start, static_cast<off_t>(map_window)));
+
+			void* mapped = mmap(nullptr, len, PROT_READ, MAP_PRIVATE, fd, start);
+			if (mapped == MAP_FAILED)
+				return offset;
+			unsigned char* data = static_cast<unsigned char*>(mapped);
+
+#ifdef MADV_SEQUENTIAL
+			madvise(data, len, MADV_SEQUENTIAL);
+#endif
+#ifdef MADV_HUGEPAGE
+			if (huge_pages)
+				madvise(data, len, MADV_HUGEPAGE);
+#else
+			(void)huge_pages;
+#endif
+			for (size_t pos = skew; pos < len; )
+			{
+				size_t step = std::min(len - pos, map_step - pos % map_step);
+				update(data + pos, step);
+				pos += step;
+#ifdef MADV_DONTNEED
+				if (pos % map_step == 0)
+					madvise(data + pos - map_step, map_step, MADV_DONTNEED);
+#endif
+			}
+			munmap(mapped, len);
+			offset = start + static_cast<off_t>(len);
+		}
+		return offset;
+	}
+
+	// Read data in large chunks; positioned reads are used when the file supports seeking.
+	// The first read uses a small stack buffer, so nothing is allocated when map_file has already absorbed the whole file.
+	template<typename F>
+	inline void read_file(int fd, off_t offset, F& update)
+	{
+		unsigned char probe[4096];
+		std::unique_ptr<unsigned char[]> chunk;
+		unsigned char* buffer = probe;
+		size_t size = sizeof(probe);
+		for (;;)
+		{
+			ssize_t res = offset >= 0 ? pread(fd, buffer, size, offset) : read(fd, buffer, size);
+			if (res < 0 && errno == EINTR)
+				continue;
+			if (res < 0)
+				throw std::runtime_error("error reading file");
+			if (res == 0)
+				break;
+			update(buffer, static_cast<size_t>(res));
+			if (offset >= 0)
+				offset += res;
+			if (!chunk)
+			{
+				chunk.reset(new unsigned char[read_chunk]);
+				buffer = chunk.get();
+				size = read_chunk;
+			}
+		}
+		if (offset >= 0)
+			lseek(fd, offset, SEEK_SET);
+	}
+
+	struct fd_guard
+	{
+		explicit fd_guard(int f) : fd(f) {}
+		~fd_guard() { close(fd); }
+		int fd;
+	};
+}
+
+// Absorb data from the current position of the file descriptor to the end of file.
+// Regular files are memory-mapped; pipes, sockets and other special files are read.
+template<typename F>
+inline void absorb_fd(int fd, bool huge_pages, F update)
+{
+	struct stat st;
+	if (fstat(fd, &st) != 0)
+		throw std::runtime_error("invalid file descriptor");
+
+	off_t offset = S_ISREG(st.st_mode) ? lseek(fd, 0, SEEK_CUR) : -1;
+	if (offset >= 0 && offset < st.st_size)
+		offset = file_functions::map_file(fd, offset, st.st_size, huge_pages, update);
+	file_functions::read_file(fd, offset, update);
+}
+
+// Absorb the whole file
+template<typename F>
+inline void absorb_file(const std::string& path, bool huge_pages, F update)
+{
+#ifdef O_CLOEXEC
+	int fd = open(path.c_str(), O_RDONLY | O_CLOEXEC);
+#else
+	int fd = open(path.c_str(), O_RDONLY);
+#endif
+	if (fd < 0)
+		throw std::runtime_error("unable to open file " + path);
+
+	file_functions::fd_guard guard(fd);
+	absorb_fd(fd, huge_pages, update);
+}
+
+#else
+
+// Absorb the whole file
+template<typename F>
+inline void absorb_file(const std::string& path, bool, F update)
+{
+	std::ifstream file(path, std::ios_base::in | std::ios_base::binary);
+	if (!file)
+		throw std::runtime_error("unable to open file " + path);
+
+	std::vector<unsigned char> buffer(1024 * 1024);
+	while (file.read(reinterpret_cast<char*>(buffer.data()), buffer.size()) || file.gcount())
+		update(buffer.data(), static_cast<size_t>(file.gcount()));
+	if (file.bad())
+		throw std::runtime_error("error reading file " + path);
+}
+
+#endif
+
+} // namespace detail
+} // namespace digestpp
+
+#endif // DIGESTPP_DETAIL_ABSORB_FILE_HPP
@@ -0,0 +1,78 @@
+/*
+This code is written by kerukuro and released into public domain.
+*/
+
+#ifndef DIGESTPP_DETAIL_ABSORB_STREAM_HPP
+#define DIGESTPP_DETAIL_ABSORB_STREAM_HPP
+
+#include <algorithm>
+#include <climits>
+#include <cstddef>
+#include <streambuf>
+#include <vector>
+
+namespace digestpp
+{
+namespace detail
+{
+
+// Access to the get area of any stream buffer.
+// Protected members are reached through pointers to members formed in a derived class, which is well-defined.
+template<typename T>
+struct streambuf_access : public std::basic_streambuf<T>
+{
+	typedef std::basic_streambuf<T> streambuf;
+	typedef typename streambuf::traits_type traits_type;
+
+	static T* get_begin(streambuf* sb) { return (sb->*&streambuf_access::gptr)(); }
+	static T* get_end(streambuf* sb) { return (sb->*&streambuf_access::egptr)(); }
+	static void consume(streambuf* sb, int n) { (sb->*&streambuf_access::gbump)(n); }
+	static bool refill(streambuf* sb)
+	{
+		return !traits_type::eq_int_type((sb->*&streambuf_access::underflow)(), traits_type::eof());
+	}
+};
+
+// Absorb all data remaining in the stream buffer.
+// Data already present in the get area is passed to update() directly, without copying.
+// When the get area is empty, data is read into the buffer if provided (which lets file buffers read
+// large chunks directly), otherwise the stream buffer is asked to refill its own get area.
+// If the stream buffer refills in small portions, a heap buffer is allocated and used instead.
+template<typename T, typename F>
+inline void absorb_streambuf(std::basic_streambuf<T>* sb, T* buffer, size_t size, F update)
+{
+	typedef streambuf_access<T> access;
+	const std::ptrdiff_t min_refill = 65536;
+	std::vector<T> own_buffer;
+	for (;;)
+	{
+		T* begin = access::get_begin(sb);
+		T* end = access::get_end(sb);
+		if (begin < end)
+		{
+			int len = static_cast<int>(std::min<std::ptrdiff_t>(end - begin, INT_MAX));
+			update(reinterpret_cast<const unsigned char*>(begin), static_cast<size_t>(len));
+			access::consume(sb, len);
+		}
+		else if (buffer && size)
+		{
+			std::streamsize len = sb->sgetn(buffer, static_cast<std::streamsize>(size));
+			if (len <= 0)
+				return;
+			update(reinterpret_cast<const unsigned char*>(buffer), static_cast<size_t>(len));
+		}
+		else if (!access::refill(sb))
+			return;
+		else if (access::get_end(sb) - access::get_begin(sb) < min_refill)
+		{
+			own_buffer.resize(min_refill);
+			buffer = own_buffer.data();
+			size = own_buffer.size();
+		}
+	}
+}
+
+} // namespace detail
+} // namespace digestpp
+
+#endif // DIGESTPP_DETAIL_ABSORB_STREAM_HPP
@@ -0,0 +1,128 @@
+/*
+This code is written by kerukuro and released into public domain.
+*/
+
+#ifndef DIGESTPP_DETAIL_CPU_FEATURES_HPP
+#define DIGESTPP_DETAIL_CPU_FEATURES_HPP
+
+// SIMD kernels are compiled for x86 with GCC, Clang and MSVC, unless disabled by defining DIGESTPP_NO_SIMD.
+// The kernels are selected at runtime based on the features reported by the CPU.
+#if !defined(DIGESTPP_NO_SIMD) && (defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)) \
+	&& (defined(__GNUC__) || defined(_MSC_VER))
+#define DIGESTPP_X86_SIMD
+#endif
+
+#ifdef DIGESTPP_X86_SIMD
+#include <immintrin.h>
+#ifdef _MSC_VER
+#include <intrin.h>
+#else
+#include <cpuid.h>
+#endif
+#endif
+
+// Allow the compiler to use instruction set extensions in a single function
+#if defined(DIGESTPP_X86_SIMD) && defined(__GNUC__)
+#define DIGESTPP_TARGET(isa) __attribute__((target(isa)))
+#else
+#define DIGESTPP_TARGET(isa)
+#endif
+
+namespace digestpp
+{
+namespace detail
+{
+
+// Instruction set extensions available on the current CPU.
+// The flags can be cleared (but not set) to force portable code paths, e.g. for testing.
+struct cpu_features
+{
+	bool sse2;
+	bool ssse3;
+	bool sse41;
+	bool avx2;
+	bool bmi2;
+	bool avx512;  // AVX-512 F, BW and VL
+	bool vbmi;    // AVX-512 VBMI
+	bool aesni;
+	bool vaes;    // VAES with AVX-512
+	bool sha;
+	bool gfni;
+
+	static cpu_features& get()
+	{
+		static cpu_features features = detect();
+		return features;
+	}
+
+	// Clear all flags, so that only portable code is used
+	void disable_all()
+	{
+		sse2 = ssse3 = sse41 = avx2 = bmi2 = avx512 = vbmi = aesni = vaes = sha = gfni = false;
+	}
+
+private:
+	static cpu_features detect()
+	{
+		cpu_features f;
+		f.disable_all();
+#ifdef DIGESTPP_X86_SIMD
+		unsigned int r1[4], r7[4] = { 0, 0, 0, 0 };
+		cpuid(0, r1);
+		unsigned int max_leaf = r1[0];
+		cpuid(1, r1);
+		if (max_leaf >= 7)
+			cpuid(7, r7);
+
+		f.sse2 = (r1[3] & (1u << 26)) != 0;
+		f.ssse3 = (r1[2] & (1u << 9)) != 0;
+		f.sse41 = (r1[2] & (1u << 19)) != 0;
+		f.aesni = (r1[2] & (1u << 25)) != 0;
+		f.sha = (r7[1] & (1u << 29)) != 0;
+		f.bmi2 = (r7[1] & (1u << 8)) != 0;
+		f.gfni = (r7[2] & (1u << 8)) != 0;
+
+		// AVX state must be enabled by the OS
+		bool osxsave = (r1[2] & (1u << 27)) != 0;
+		unsigned long long xcr0 = osxsave ? xgetbv() : 0;
+		bool os_avx = (xcr0 & 0x06) == 0x06;
+		bool os_avx512 = (xcr0 & 0xe6) == 0xe6;
+
+		f.avx2 = os_avx && (r1[2] & (1u << 28)) && (r7[1] & (1u << 5));
+		f.avx512 = f.avx2 && os_avx512 && (r7[1] & (1u << 16)) && (r7[1] & (1u << 30)) && (r7[1] & (1u << 31));
+		f.vbmi = f.avx512 && (r7[2] & (1u << 1));
+		f.vaes = f.avx512 && f.aesni && (r7[2] & (1u << 9));
+#endif
+		return f;
+	}
+
+#ifdef DIGESTPP_X86_SIMD
+	static void cpuid(unsigned int leaf, unsigned int regs[4])
+	{
+#ifdef _MSC_VER
+		int r[4];
+		__cpuidex(r, static_cast<int>(leaf), 0);
+		for (int i = 0; i < 4; i++)
+			regs[i] = static_cast<unsigned int>(r[i]);
+#else
+		__cpuid_count(leaf, 0, regs[0], regs[1], regs[2], regs[3]);
+#endif
+	}
+
+	static unsigned long long xgetbv()
+	{
+#ifdef _MSC_VER
+		return _xgetbv(0);
+#else
+		unsigned int eax, edx;
+		__asm__ __volatile__("xgetbv" : "=a"(eax), "=d"(edx) : "c"(0));
+		return (static_cast<unsigned long long>(edx) << 32) | eax;
+#endif
+	}
+#endif
+};
+
+} // namespace detail
+} // namespace digestpp
+
+#endif // DIGESTPP_DETAIL_CPU_FEATURES_HPP
@@ -0,0 +1,118 @@
+/*
+This code is written by kerukuro and released into public domain.
+*/
+
+#ifndef DIGESTPP_DETAIL_DIGEST_VALUE_HPP
+#define DIGESTPP_DETAIL_DIGEST_VALUE_HPP
+
+#include <array>
+#include <cstring>
+#include <string>
+
+#include "hex.hpp"
+
+namespace digestpp
+{
+
+/**
+ * \brief Binary digest of a size known at compile time
+ *
+ * Returned by \ref hasher::digest() for hash functions with output size fixed at compile time.
+ * The bytes are stored inside the object, so no heap allocation is needed.
+ *
+ * \param N Size of the digest (in bytes)
+ *
+ * \sa hasher, bounded_digest
+ */
+template<size_t N>
+class fixed_digest
+{
+public:
+	typedef unsigned char value_type;
+	typedef const unsigned char* const_iterator;
+
+	unsigned char* data() { return bytes.data(); }
+	const unsigned char* data() const { return bytes.data(); }
+	constexpr size_t size() const { return N; }
+
+	const_iterator begin() const { return bytes.data(); }
+	const_iterator end() const { return bytes.data() + N; }
+
+	unsigned char operator[](size_t i) const { return bytes[i]; }
+
+	/**
+	 * \brief Return the digest as a hexadecimal string
+	 */
+	std::string hex() const
+	{
+		std::string res(N * 2, '0');
+		detail::hex_encode(bytes.data(), N, &res[0]);
+		return res;
+	}
+
+	bool operator==(const fixed_digest& other) const { return !memcmp(bytes.data(), other.bytes.data(), N); }
+	bool operator!=(const fixed_digest& other) const { return !(*this == other); }
+	bool operator<(const fixed_digest& other) const { return memcmp(bytes.data(), other.bytes.data(), N) < 0; }
+
+private:
+	std::array<unsigned char, N> bytes;
+};
+
+/**
+ * \brief Binary digest of a size chosen at runtime, up to a compile-time limit
+ *
+ * Returned by \ref hasher::digest() for hash functions with output size specified in the constructor.
+ * The bytes are stored inside the object, so no heap allocation is needed.
+ *
+ * \param N Maximum size of the digest (in bytes)
+ *
+ * \sa hasher, fixed_digest
+ */
+template<size_t N>
+class bounded_digest
+{
+public:
+	typedef unsigned char value_type;
+	typedef const unsigned char* const_iterator;
+
+	explicit bounded_digest(size_t size = 0) : len(size < N ? size : N) {}
+
+	unsigned char* data() { return bytes.data(); }
+	const unsigned char* data() const { return bytes.data(); }
+	size_t size() const { return len; }
+
+	const_iterator begin() const { return bytes.data(); }
+	const_iterator end() const { return bytes.data() + len; }
+
+	unsigned char operator[](size_t i) const { return bytes[i]; }
+
+	/**
+	 * \brief Return the digest as a hexadecimal string
+	 */
+	std::string hex() const
+	{
+		std::string res(len * 2, '0');
+		if (len)
+			detail::hex_encode(bytes.data(), len, &res[0]);
+		return res;
+	}
+
+	bool operator==(const bounded_digest& other) const
+	{
+		return len == other.len && !memcmp(bytes.data(), other.bytes.data(), len);
+	}
+	bool operator!=(const bounded_digest& other) const { return !(*this == other); }
+	bool operator<(const bounded_digest& other) const
+	{
+		int res = memcmp(bytes.data(), other.bytes.data(), len < other.len ? len : other.len);
+		return res < 0 || (!res && len < other.len);
+	}
+
+private:
+	std::array<unsigned char, N> bytes;
+	size_t len;
+};
+
+} // namespace digestpp
+
+#endif // DIGESTPP_DETAIL_DIGEST_VALUE_HPP
@@ -0,0 +1,141 @@
+/*
+This code is written by kerukuro and released into public domain.
+*/
+
+#ifndef DIGESTPP_DETAIL_HEX_HPP
+#define DIGESTPP_DETAIL_HEX_HPP
+
+#include <cstddef>
+#include "cpu_features.hpp"
+
+namespace digestpp
+{
+namespace detail
+{
+
+namespace hex_functions
+{
+	template<typename V>
+	struct hex_constants
+	{
+		const static char pairs[513];
+	};
+
+	template<typename V>
+	const char hex_constants<V>::pairs[513] =
+		"000102030405060708090a0b0c0d0e0f101112131415161718191a1b1c1d1e1f"
+		"202122232425262728292a2b2c2d2e2f303132333435363738393a3b3c3d3e3f"
+		"404142434445464748494a4b4c4d4e4f505152535455565758595a5b5c5d5e5f"
+		"606162636465666768696a6b6c6d6e6f707172737475767778797a7b7c7d7e7f"
+		"808182838485868788898a8b8c8d8e8f909192939495969798999a9b9c9d9e9f"
+		"a0a1a2a3a4a5a6a7a8a9aaabacadaeafb0b1b2b3b4b5b6b7b8b9babbbcbdbebf"
+		"c0c1c2c3c4c5c6c7c8c9cacbcccdcecfd0d1d2d3d4d5d6d7d8d9dadbdcdddedf"
+		"e0e1e2e3e4e5e6e7e8e9eaebecedeeeff0f1f2f3f4f5f6f7f8f9fafbfcfdfeff";
+
+	inline void encode_scalar(const unsigned char* data, size_t len, char* out)
+	{
+		const char* pairs = hex_constants<void>::pairs;
+		for (size_t i = 0; i < len; i++)
+		{
+			out[i * 2] = pairs[data[i] * 2];
+			out[i * 2 + 1] = pairs[data[i] * 2 + 1];
+		}
+	}
+
+#ifdef DIGESTPP_X86_SIMD
+	// Encode 16 bytes at a time, looking up both nibbles of each byte with pshufb
+	DIGESTPP_TARGET("ssse3")
+	inline void encode_ssse3(const unsigned char* data, size_t blocks, char* out)
+	{
+		const __m128i digits = _mm_setr_epi8('0', '1', '2', '3', '4', '5', '6', '7',
+				'8', '9', 'a', 'b', 'c', 'd', 'e', 'f');
+		const __m128i mask = _mm_set1_epi8(0x0f);
+		for (size_t i = 0; i < blocks; i++)
+		{
+			__m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i * 16));
+			__m128i hi = _mm_shuffle_epi8(digits, _mm_and_si128(_mm_srli_epi16(v, 4), mask));
+			__m128i lo = _mm_shuffle_epi8(digits, _mm_and_si128(v, mask));
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(out + i * 32), _mm_unpacklo_epi8(hi, lo));
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(out + i * 32 + 16), _mm_unpackhi_epi8(hi, lo));
+		}
+	}
+
+	// Encode 32 bytes at a time; unpacking works within 128-bit lanes, so the halves are reordered before storing
+	DIGESTPP_TARGET("avx2")
+	inline void encode_avx2(const unsigned char* data, size_t blocks, char* out)
+	{
+		const __m256i digits = _mm256_setr_epi8('0', '1', '2', '3', '4', '5', '6', '7',
+				'8', '9', 'a', 'b', 'c', 'd', 'e', 'f',
+				'0', '1', '2', '3', '4', '5', '6', '7',
+				'8', '9', 'a', 'b', 'c', 'd', 'e', 'f');
+		const __m256i mask = _mm256_set1_epi8(0x0f);
+		for (size_t i = 0; i < blocks; i++)
+		{
+			__m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i * 32));
+			__m256i hi = _mm256_shuffle_epi8(digits, _mm256_and_si256(_mm256_srli_epi16(v, 4), mask));
+			__m256i lo = _mm256_shuffle_epi8(digits, _mm256_and_si256(v, mask));
+			__m256i first = _mm256_unpacklo_epi8(hi, lo);
+			__m256i second = _mm256_unpackhi_epi8(hi, lo);
+			_mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i * 64), _mm256_permute2x128_si256(first, second, 0x20));
+			_mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i * 64 + 32), _mm256_permute2x128_si256(first, second, 0x31));
+		}
+	}
+#endif
+
+	// Value of a hex digit, or a value above 15 for other characters
+	inline unsigned int digit_value(char c)
+	{
+		unsigned int v = static_cast<unsigned char>(c);
+		if (v - '0' < 10)
+			return v - '0';
+		v |= 0x20; // lowercase
+		if (v - 'a' < 6)
+			return v - 'a' + 10;
+		return 0x100;
+	}
+}
+
+// Write 2 * len lowercase hex characters representing the data to out (no terminating zero).
+inline void hex_encode(const unsigned char* data, size_t len, char* out)
+{
+#ifdef DIGESTPP_X86_SIMD
+	const cpu_features& cpu = cpu_features::get();
+	if (len >= 32 && cpu.avx2)
+	{
+		size_t blocks = len / 32;
+		hex_functions::encode_avx2(data, blocks, out);
+		data += blocks * 32;
+		out += blocks * 64;
+		len -= blocks * 32;
+	}
+	if (len >= 16 && cpu.ssse3)
+	{
+		size_t blocks = len / 16;
+		hex_functions::encode_ssse3(data, blocks, out);
+		data += blocks * 16;
+		out += blocks * 32;
+		len -= blocks * 16;
+	}
+#endif
+	hex_functions::encode_scalar(data, len, out);
+}
+
+// Convert 2 * len hex characters (in any case) to len bytes.
+// Returns false if the input contains characters other than hex digits.
+inline bool hex_decode(const char* hex, size_t len, unsigned char* out)
+{
+	unsigned int invalid = 0;
+	for (size_t i = 0; i < len; i++)
+	{
+		unsigned int hi = hex_functions::digit_value(hex[i * 2]);
+		unsigned int lo = hex_functions::digit_value(hex[i * 2 + 1]);
+		invalid |= hi | lo;
+		out[i] = static_cast<unsigned char>((hi << 4) | (lo & 0x0f));
+	}
+	return invalid < 0x10;
+}
+
+} // namespace detail
+} // namespace digestpp
+
+#endif // DIGESTPP_DETAIL_HEX_HPP
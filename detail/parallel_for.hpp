@@ -0,0 +1,64 @@
+/*
+This code is written by kerukuro and released into public domain.
+*/
+
+#ifndef DIGESTPP_DETAIL_PARALLEL_FOR_HPP
+#define DIGESTPP_DETAIL_PARALLEL_FOR_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <thread>
+#include <vector>
+
+namespace digestpp
+{
+namespace detail
+{
+
+// Call fn(begin, end) for consecutive ranges that cover [0, count), using up to the given number of threads.
+// Every range except the last has a multiple of grain items. The calling thread processes the first range,
+// and also the remaining ranges if no more threads can be started.
+template<typename F>
+inline void parallel_for(size_t count, size_t grain, size_t threads, F fn)
+{
+	if (threads < 2 || count <= grain)
+	{
+		fn(size_t(0), count);
+		return;
+	}
+
+	size_t per_thread = ((count + threads - 1) / threads + grain - 1) / grain * grain;
+	size_t own = std::min(per_thread, count);
+	size_t begin = own;
+	std::vector<std::thread> workers;
+
+	// Threads are joined on every path out of this function, including exceptions thrown by fn
+	struct joiner
+	{
+		std::vector<std::thread>& workers;
+		~joiner()
+		{
+			for (auto& worker : workers)
+				worker.join();
+		}
+	} join_workers = { workers };
+
+	try
+	{
+		workers.reserve(threads - 1);
+		for (; begin < count; begin += per_thread)
+			workers.emplace_back(fn, begin, std::min(begin + per_thread, count));
+	}
+	catch (...)
+	{
+		// Ranges that could not be given to a thread are processed by this one
+	}
+	fn(size_t(0), own);
+	if (begin < count)
+		fn(begin, count);
+}
+
+} // namespace detail
+} // namespace digestpp
+
+#endif // DIGESTPP_DETAIL_PARALLEL_FOR_HPP
@@ -6,6 +6,10 @@ This code is written by kerukuro and released into public domain.
 #define DIGESTPP_DETAIL_TRAITS_HPP
 
 #include <cstddef> // needed for testing std::byte
+#include <iterator>
+#include <string>
+#include <type_traits>
+#include <vector>
 
 namespace digestpp
 {
@@ -29,6 +33,55 @@ struct is_byte
 			std::is_same<T, unsigned char>::value;
 };
 
+// Output size (in bits) fixed at compile time, or 0 if the output size is chosen at runtime.
+// Providers advertise it with a static_hash_size member.
+template <typename T, typename = void>
+struct static_hash_size
+{
+	static const size_t value = 0;
+};
+
+template <typename T>
+struct static_hash_size<T, decltype(void(T::static_hash_size))>
+{
+	static const size_t value = T::static_hash_size;
+};
+
+// Upper bound (in bits) of the output size, or 0 if it is unknown or unlimited.
+// Providers advertise it with a max_hash_size member.
+template <typename T, typename = void>
+struct max_hash_size
+{
+	static const size_t value = 0;
+};
+
+template <typename T>
+struct max_hash_size<T, decltype(void(T::max_hash_size))>
+{
+	static const size_t value = T::max_hash_size;
+};
+
+// Detects iterators over contiguous storage of bytes, which can be absorbed with a single update() call.
+// Before C++20 only pointers and iterators of std::vector and std::string are recognized.
+template <typename IT, typename V = typename std::iterator_traits<IT>::value_type, bool = is_byte<V>::value>
+struct is_contiguous_iterator
+{
+	static const bool value = false;
+};
+
+template <typename IT, typename V>
+struct is_contiguous_iterator<IT, V, true>
+{
+	static const bool value = std::is_pointer<IT>::value ||
+#if defined(__cpp_lib_concepts) && __cpp_lib_concepts >= 202002L
+			std::contiguous_iterator<IT> ||
+#endif
+			std::is_same<IT, typename std::vector<V>::iterator>::value ||
+			std::is_same<IT, typename std::vector<V>::const_iterator>::value ||
+			std::is_same<IT, std::string::iterator>::value ||
+			std::is_same<IT, std::string::const_iterator>::value;
+};
+
 } // namespace detail
 } // namespace digestpp
 
@@ -16,7 +16,10 @@ This code is written by kerukuro and released into public domain.
 #include <cstdint>
 
 #include "detail/traits.hpp"
-#include "detail/stream_width_fixer.hpp"
+#include "detail/absorb_file.hpp"
+#include "detail/absorb_stream.hpp"
+#include "detail/digest_value.hpp"
+#include "detail/hex.hpp"
 #include "algorithm/mixin/null_mixin.hpp"
 
 namespace digestpp
@@ -151,22 +154,92 @@ class hasher : public Mixin<HashProvider>
 	template<typename T, typename std::enable_if<detail::is_byte<T>::value>::type* = nullptr>
 	inline hasher& absorb(std::basic_istream<T>& istr)
 	{
-		const int tmp_buffer_size = 65536;
-		unsigned char buffer[tmp_buffer_size];
-		while (istr.read(reinterpret_cast<T*>(buffer), sizeof(buffer)))
-		{
-			provider.update(buffer, sizeof(buffer));
-		}
-		size_t gcount = istr.gcount();
-		if (gcount)
-		{
-			provider.update(buffer, gcount);
-		}
+		return absorb(istr, static_cast<T*>(nullptr), 0);
+	}
+
+	/**
+	 * \brief Absorbs bytes from std::istream, using a caller-provided buffer for reading
+	 *
+	 * Data already buffered by the stream is absorbed in place. The buffer is used when the stream
+	 * has to read more data; a large buffer allows file streams to read directly into it in big chunks.
+	 * The buffer can be reused between calls. After all data is absorbed, eofbit is set on the stream.
+	 *
+	 * \param[in] istr Stream to absorb
+	 * \param[in] buffer Buffer for reading data; if nullptr, the stream's own buffer is used
+	 * \param[in] size Size of the buffer (in bytes)
+	 * \return Reference to *this
+	 * @par Example:
+	 * @code // Calculate SHA-256 digests of files, reading them through a reusable 1 MiB buffer
+	 * std::vector<char> buffer(1024 * 1024);
+	 * for (const std::string& name : filenames)
+	 * {
+	 *     std::ifstream file(name, std::ios_base::in|std::ios_base::binary);
+	 *     std::cout << digestpp::sha256().absorb(file, buffer.data(), buffer.size()).hexdigest() << std::endl;
+	 * }
+	 * @endcode
+	 */
+	template<typename T, typename std::enable_if<detail::is_byte<T>::value>::type* = nullptr>
+	inline hasher& absorb(std::basic_istream<T>& istr, T* buffer, size_t size)
+	{
+		typename std::basic_istream<T>::sentry sentry(istr, true);
+		if (!sentry || !istr.rdbuf())
+			return *this;
+
+		detail::absorb_streambuf(istr.rdbuf(), buffer, size,
+			[this](const unsigned char* data, size_t len) { provider.update(data, len); });
+		istr.setstate(std::ios_base::eofbit);
+		return *this;
+	}
+
+	/**
+	 * \brief Absorbs contents of a file
+	 *
+	 * On POSIX systems regular files are memory-mapped and the mapped pages are passed to the algorithm directly,
+	 * with already processed pages released, so that memory usage stays flat for files of any size.
+	 * Other files (and files on other systems) are read in large chunks.
+	 *
+	 * \param[in] path Path to the file
+	 * \param[in] huge_pages Advise the OS to use huge pages for the mapping, if supported
+	 * \return Reference to *this
+	 * \throw std::runtime_error if the file can't be opened or read
+	 * @par Example:
+	 * @code // Calculate SHA-256 digest of a file and output it in hex format
+	 * std::cout << digestpp::sha256().absorb_file("filename").hexdigest() << std::endl;
+	 * @endcode
+	 */
+	inline hasher& absorb_file(const std::string& path, bool huge_pages = false)
+	{
+		detail::absorb_file(path, huge_pages, [this](const unsigned char* data, size_t len) { provider.update(data, len); });
 		return *this;
 	}
 
+#ifdef DIGESTPP_POSIX_FILES
+	/**
+	 * \brief Absorbs data from a file descriptor, from the current position to the end of file
+	 *
+	 * Regular files are memory-mapped, pipes, sockets and other special files are read in large chunks.
+	 * The file position is moved to the end of the absorbed data. The descriptor is not closed.
+	 *
+	 * \available_if The system supports POSIX file API
+	 *
+	 * \param[in] fd File descriptor open for reading
+	 * \param[in] huge_pages Advise the OS to use huge pages for the mapping, if supported
+	 * \return Reference to *this
+	 * \throw std::runtime_error if reading from the descriptor fails
+	 */
+	inline hasher& absorb_fd(int fd, bool huge_pages = false)
+	{
+		detail::absorb_fd(fd, huge_pages, [this](const unsigned char* data, size_t len) { provider.update(data, len); });
+		return *this;
+	}
+#endif
+
 	/**
 	 * \brief Absorbs bytes from an iterator sequence
+	 *
+	 * Ranges of bytes in contiguous storage (pointers, std::vector and std::string iterators, or any
+	 * contiguous iterator in C++20) are absorbed in a single call; other sequences are read in chunks.
+	 *
 	 * \param[in] begin Begin iterator
 	 * \param[in] end End iterator
 	 * \return Reference to *this
@@ -181,11 +254,7 @@ class hasher : public Mixin<HashProvider>
 	template<typename IT>
 	inline hasher& absorb(IT begin, IT end)
 	{
-		while (begin != end)
-		{
-			unsigned char byte = *begin++;
-			provider.update(&byte, 1);
-		}
+		absorb_range(begin, end, std::integral_constant<bool, detail::is_contiguous_iterator<IT>::value>());
 		return *this;
 	}
 
@@ -295,10 +364,36 @@ class hasher : public Mixin<HashProvider>
 	template<typename H=HashProvider, typename std::enable_if<detail::is_xof<H>::value>::type* = nullptr>
 	inline std::string hexsqueeze(size_t len)
 	{
-		std::ostringstream res;
-		res << std::setfill('0') << std::hex;
-		squeeze(len, std::ostream_iterator<detail::stream_width_fixer<unsigned int, 2>>(res, ""));
-		return res.str();
+		std::string res(len * 2, '0');
+		if (len)
+			hexsqueeze_to(&res[0], len);
+		return res;
+	}
+
+	/**
+	 * \brief Squeeze bytes and write them in hex format into user-provided preallocated buffer.
+	 *
+	 * After each invocation of this function the internal state of the hasher changes
+	 * so that the next call will generate different (additional) output bytes.
+	 * To reset the state and start new digest calculation, use \ref reset function.
+	 *
+	 * \available_if HashProvider is an extendable output function (XOF)
+	 *
+	 * \param[out] out Buffer for 2 * len hexadecimal characters (no terminating zero is written)
+	 * \param[in] len Size of data to squeeze (in bytes)
+	 */
+	template<typename H=HashProvider, typename std::enable_if<detail::is_xof<H>::value>::type* = nullptr>
+	inline void hexsqueeze_to(char* out, size_t len)
+	{
+		unsigned char buffer[256];
+		while (len)
+		{
+			size_t chunk = std::min(len, sizeof(buffer));
+			provider.squeeze(buffer, chunk);
+			detail::hex_encode(buffer, chunk, out);
+			out += chunk * 2;
+			len -= chunk;
+		}
 	}
 
 	/**
@@ -348,10 +443,58 @@ class hasher : public Mixin<HashProvider>
 	template<typename OI, typename H=HashProvider, typename std::enable_if<!detail::is_xof<H>::value>::type* = nullptr>
 	inline void digest(OI it) const
 	{
+		with_digest([&](const unsigned char* hash, size_t len) { std::copy(hash, hash + len, it); });
+	}
+
+	/**
+	 * \brief Return binary digest as a value with inline storage.
+	 *
+	 * This function does not change the state of the hasher and can be called multiple times, producing the same result.
+	 * To reset the state and start new digest calculation, use \ref reset function.
+	 *
+	 * \available_if HashProvider is a hash function (not XOF) with output size fixed at compile time
+	 *
+	 * \return Calculated digest as \ref fixed_digest
+	 * @par Example:
+	 * @code // Calculate SHA-256 digest without heap allocations
+	 * auto d = digestpp::sha256().absorb("The quick brown fox jumps over the lazy dog").digest();
+	 * std::cout << d.hex() << std::endl;
+	 * @endcode
+	 */
+	template<typename H=HashProvider, typename std::enable_if<!detail::is_xof<H>::value
+		&& detail::static_hash_size<H>::value != 0>::type* = nullptr>
+	inline fixed_digest<detail::static_hash_size<H>::value / 8> digest() const
+	{
+		fixed_digest<detail::static_hash_size<H>::value / 8> res;
 		HashProvider copy(provider);
-		std::vector<unsigned char> hash(provider.hash_size() / 8);
-		copy.final(&hash[0]);
-		std::copy(hash.begin(), hash.end(), it);
+		copy.final(res.data());
+		return res;
+	}
+
+	/**
+	 * \brief Return binary digest as a value with inline storage.
+	 *
+	 * This function does not change the state of the hasher and can be called multiple times, producing the same result.
+	 * To reset the state and start new digest calculation, use \ref reset function.
+	 *
+	 * \available_if HashProvider is a hash function (not XOF) with output size specified at runtime
+	 * and limited by the algorithm
+	 *
+	 * \return Calculated digest as \ref bounded_digest sized for the largest output of the algorithm
+	 * @par Example:
+	 * @code // Calculate BLAKE2b-256 digest without heap allocations
+	 * auto d = digestpp::blake2b(256).absorb("The quick brown fox jumps over the lazy dog").digest();
+	 * std::cout << d.hex() << std::endl;
+	 * @endcode
+	 */
+	template<typename H=HashProvider, typename std::enable_if<!detail::is_xof<H>::value
+		&& detail::static_hash_size<H>::value == 0 && detail::max_hash_size<H>::value != 0>::type* = nullptr>
+	inline bounded_digest<detail::max_hash_size<H>::value / 8> digest() const
+	{
+		bounded_digest<detail::max_hash_size<H>::value / 8> res(provider.hash_size() / 8);
+		HashProvider copy(provider);
+		copy.final(res.data());
+		return res;
 	}
 
 	/**
@@ -371,12 +514,116 @@ class hasher : public Mixin<HashProvider>
 	template<typename H=HashProvider, typename std::enable_if<!detail::is_xof<H>::value>::type* = nullptr>
 	inline std::string hexdigest() const
 	{
-		std::ostringstream res;
-		res << std::setfill('0') << std::hex;
-		digest(std::ostream_iterator<detail::stream_width_fixer<unsigned int, 2>>(res, ""));
-		return res.str();
+		std::string res(provider.hash_size() / 4, '0');
+		hexdigest_to(&res[0]);
+		return res;
+	}
+
+	/**
+	 * \brief Write hex digest of absorbed data into user-provided preallocated buffer.
+	 *
+	 * This function does not change the state of the hasher and can be called multiple times, producing the same result.
+	 * To reset the state and start new digest calculation, use \ref reset function.
+	 *
+	 * \available_if HashProvider is a hash function (not XOF)
+	 *
+	 * \param[out] out Buffer for hash_size / 4 hexadecimal characters (no terminating zero is written)
+	 * @par Example:
+	 * @code // Write SHA-256 digest in hex format to a C array
+	 * char buf[65] = {};
+	 * digestpp::sha256().absorb("The quick brown fox jumps over the lazy dog").hexdigest_to(buf);
+	 * @endcode
+	 */
+	template<typename H=HashProvider, typename std::enable_if<!detail::is_xof<H>::value>::type* = nullptr>
+	inline void hexdigest_to(char* out) const
+	{
+		with_digest([&](const unsigned char* hash, size_t len) { detail::hex_encode(hash, len, out); });
+	}
+
+	/**
+	 * \brief Compare digest of absorbed data with expected hex digest.
+	 *
+	 * Hex digits can be in any case. All characters are checked, regardless of the position of the first difference.
+	 * This function does not change the state of the hasher.
+	 *
+	 * \available_if HashProvider is a hash function (not XOF)
+	 *
+	 * \param[in] expected Expected digest in hex format
+	 * \param[in] len Length of expected digest (in characters)
+	 * \return true if the digest matches the expected value
+	 * @par Example:
+	 * @code // Check SHA-256 digest of a string
+	 * bool ok = digestpp::sha256().absorb("The quick brown fox jumps over the lazy dog")
+	 *     .verify_hex("d7a8fbb307d7809469ca9abcb0082e4f8d5651e46d3cdb762d02d0bf37c9e592");
+	 * @endcode
+	 */
+	template<typename H=HashProvider, typename std::enable_if<!detail::is_xof<H>::value>::type* = nullptr>
+	inline bool verify_hex(const char* expected, size_t len) const
+	{
+		if (len != provider.hash_size() / 4)
+			return false;
+
+		bool res = true;
+		with_digest([&](const unsigned char* hash, size_t hashlen) {
+			unsigned char buffer[64];
+			unsigned int diff = 0;
+			for (size_t pos = 0; pos < hashlen; pos += sizeof(buffer))
+			{
+				size_t chunk = std::min(hashlen - pos, sizeof(buffer));
+				if (!detail::hex_decode(expected + pos * 2, chunk, buffer))
+					diff = 1;
+				for (size_t i = 0; i < chunk; i++)
+					diff |= buffer[i] ^ hash[pos + i];
+			}
+			res = !diff;
+		});
+		return res;
 	}
 
+	/**
+	 * \brief Compare digest of absorbed data with expected hex digest.
+	 *
+	 * \available_if HashProvider is a hash function (not XOF)
+	 *
+	 * \param[in] expected Expected digest in hex format, as zero-terminated string
+	 * \return true if the digest matches the expected value
+	 */
+	template<typename H=HashProvider, typename std::enable_if<!detail::is_xof<H>::value>::type* = nullptr>
+	inline bool verify_hex(const char* expected) const
+	{
+		return verify_hex(expected, strlen(expected));
+	}
+
+	/**
+	 * \brief Compare digest of absorbed data with expected hex digest.
+	 *
+	 * \available_if HashProvider is a hash function (not XOF)
+	 *
+	 * \param[in] expected Expected digest in hex format
+	 * \return true if the digest matches the expected value
+	 */
+	template<typename H=HashProvider, typename std::enable_if<!detail::is_xof<H>::value>::type* = nullptr>
+	inline bool verify_hex(const std::string& expected) const
+	{
+		return verify_hex(expected.data(), expected.size());
+	}
+
+#if defined(__cpp_lib_string_view) && __cpp_lib_string_view >= 201606
+	/**
+	 * \brief Compare digest of absorbed data with expected hex digest.
+	 *
+	 * \available_if HashProvider is a hash function (not XOF)
+	 *
+	 * \param[in] expected Expected digest in hex format
+	 * \return true if the digest matches the expected value
+	 */
+	template<typename H=HashProvider, typename std::enable_if<!detail::is_xof<H>::value>::type* = nullptr>
+	inline bool verify_hex(std::string_view expected) const
+	{
+		return verify_hex(expected.data(), expected.size());
+	}
+#endif
+
 	/**
 	 * \brief Reset the hasher state to start new digest computation.
 	 *
@@ -390,6 +637,54 @@ class hasher : public Mixin<HashProvider>
 	}
 
 private:
+	// Contiguous byte range: pass the whole range to the provider at once
+	template<typename IT>
+	inline void absorb_range(IT begin, IT end, std::true_type)
+	{
+		if (begin != end)
+			provider.update(reinterpret_cast<const unsigned char*>(&*begin), static_cast<size_t>(std::distance(begin, end)));
+	}
+
+	// Any other iterator: collect elements into a small buffer and absorb it in chunks
+	template<typename IT>
+	inline void absorb_range(IT begin, IT end, std::false_type)
+	{
+		unsigned char buffer[1024];
+		while (begin != end)
+		{
+			size_t len = 0;
+			while (len < sizeof(buffer) && begin != end)
+				buffer[len++] = static_cast<unsigned char>(*begin++);
+			provider.update(buffer, len);
+		}
+	}
+
+	// Finalize a copy of the provider and pass the digest to f(const unsigned char* hash, size_t len)
+	template<typename F>
+	inline void with_digest(F f) const
+	{
+		with_digest(f, std::integral_constant<bool, detail::max_hash_size<HashProvider>::value != 0>());
+	}
+
+	// Output size is limited: finalize into a buffer on the stack
+	template<typename F>
+	inline void with_digest(F f, std::true_type) const
+	{
+		unsigned char hash[detail::max_hash_size<HashProvider>::value / 8];
+		HashProvider copy(provider);
+		copy.final(hash);
+		f(static_cast<const unsigned char*>(hash), provider.hash_size() / 8);
+	}
+
+	template<typename F>
+	inline void with_digest(F f, std::false_type) const
+	{
+		std::vector<unsigned char> hash(provider.hash_size() / 8);
+		HashProvider copy(provider);
+		copy.final(&hash[0]);
+		f(static_cast<const unsigned char*>(hash.data()), hash.size());
+	}
+
 	friend Mixin<HashProvider>;
 	HashProvider provider;
 };
@@ -0,0 +1,264 @@
+#include <digestpp/digestpp.hpp>
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <deque>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <numeric>
+#include <sstream>
+#include <vector>
+
+const size_t data_size = 8 * 1024 * 1024;
+
+// Run the function several times and return the best throughput in MB/s
+template<typename F>
+double throughput(size_t bytes, F f)
+{
+	double best = 0;
+	for (int i = 0; i < 3; i++)
+	{
+		auto start = std::chrono::steady_clock::now();
+		f();
+		std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+		best = std::max(best, bytes / elapsed.count() / 1e6);
+	}
+	return best;
+}
+
+template<typename H>
+std::string result(H& hasher)
+{
+	unsigned char buf[64];
+	hasher.squeeze(buf, sizeof(buf));
+	return std::string(reinterpret_cast<char*>(buf), sizeof(buf));
+}
+
+template<typename H, template<typename> class M, typename std::enable_if<!digestpp::detail::is_xof<H>::value>::type* = nullptr>
+std::string result(digestpp::hasher<H, M>& hasher)
+{
+	return hasher.hexdigest();
+}
+
+template<typename H>
+void output(H& hasher, unsigned char* out, size_t size)
+{
+	hasher.squeeze(out, size);
+}
+
+template<typename H, template<typename> class M, typename std::enable_if<!digestpp::detail::is_xof<H>::value>::type* = nullptr>
+void output(digestpp::hasher<H, M>& hasher, unsigned char* out, size_t)
+{
+	hasher.digest(out);
+}
+
+// Compare absorbing the same data from a pointer, a contiguous iterator and a non-contiguous iterator
+template<typename H>
+void bench_absorb(const char* name, const H& hasher)
+{
+	std::vector<unsigned char> v(data_size);
+	std::iota(v.begin(), v.end(), 0);
+	std::deque<unsigned char> d(v.begin(), v.end());
+	std::string sink;
+
+	double ptr = throughput(v.size(), [&] { H h(hasher); sink += result(h.absorb(v.data(), v.size())); });
+	double vec = throughput(v.size(), [&] { H h(hasher); sink += result(h.absorb(v.begin(), v.end())); });
+	double deq = throughput(v.size(), [&] { H h(hasher); sink += result(h.absorb(d.begin(), d.end())); });
+
+	std::cout << std::left << std::setw(16) << name << std::right << std::fixed << std::setprecision(1)
+		<< std::setw(10) << ptr << std::setw(10) << vec << std::setw(10) << deq
+		<< std::setw(9) << vec / ptr * 100 << '%' << std::setw(9) << deq / ptr * 100 << '%' << std::endl;
+}
+
+void bench_iterators()
+{
+	std::cout << "Absorb throughput, MB/s" << std::endl;
+	std::cout << std::left << std::setw(16) << "algorithm" << std::right << std::setw(10) << "pointer"
+		<< std::setw(10) << "vector" << std::setw(10) << "deque" << std::setw(10) << "vector/p"
+		<< std::setw(10) << "deque/p" << std::endl;
+
+	bench_absorb("ascon_hash", digestpp::ascon_hash());
+	bench_absorb("ascon_xof", digestpp::ascon_xof());
+	bench_absorb("blake/256", digestpp::blake(256));
+	bench_absorb("blake/512", digestpp::blake(512));
+	bench_absorb("blake2s/256", digestpp::blake2s(256));
+	bench_absorb("blake2b/512", digestpp::blake2b(512));
+	bench_absorb("blake2xs/256", digestpp::blake2xs(256));
+	bench_absorb("blake2xb/512", digestpp::blake2xb(512));
+	bench_absorb("blake2sp/256", digestpp::blake2sp(256));
+	bench_absorb("blake2bp/512", digestpp::blake2bp(512));
+	bench_absorb("echo/256", digestpp::echo(256));
+	bench_absorb("echo/512", digestpp::echo(512));
+	bench_absorb("esch/256", digestpp::esch(256));
+	bench_absorb("esch/384", digestpp::esch(384));
+	bench_absorb("groestl/256", digestpp::groestl(256));
+	bench_absorb("groestl/512", digestpp::groestl(512));
+	bench_absorb("jh/256", digestpp::jh(256));
+	bench_absorb("jh/512", digestpp::jh(512));
+	bench_absorb("k12", digestpp::k12());
+	bench_absorb("m14", digestpp::m14());
+	bench_absorb("kmac128", digestpp::kmac128(256));
+	bench_absorb("kmac256", digestpp::kmac256(512));
+	bench_absorb("kupyna/256", digestpp::kupyna(256));
+	bench_absorb("kupyna/512", digestpp::kupyna(512));
+	bench_absorb("lsh256/256", digestpp::lsh256(256));
+	bench_absorb("lsh512/512", digestpp::lsh512(512));
+	bench_absorb("md5", digestpp::md5());
+	bench_absorb("sha1", digestpp::sha1());
+	bench_absorb("sha256", digestpp::sha256());
+	bench_absorb("sha512", digestpp::sha512());
+	bench_absorb("sha3/256", digestpp::sha3(256));
+	bench_absorb("sha3/512", digestpp::sha3(512));
+	bench_absorb("shake128", digestpp::shake128());
+	bench_absorb("shake256", digestpp::shake256());
+	bench_absorb("cshake256", digestpp::cshake256());
+	bench_absorb("skein256/256", digestpp::skein256(256));
+	bench_absorb("skein512/512", digestpp::skein512(512));
+	bench_absorb("skein1024/1024", digestpp::skein1024(1024));
+	bench_absorb("sm3", digestpp::sm3());
+	bench_absorb("streebog/256", digestpp::streebog(256));
+	bench_absorb("streebog/512", digestpp::streebog(512));
+	bench_absorb("whirlpool", digestpp::whirlpool());
+}
+
+// Compare absorbing a file and a string through streams with absorbing it from memory
+template<typename H>
+void bench_stream(const char* name, const H& hasher)
+{
+	const char* filename = "digestpp_benchmark.tmp";
+	std::string data(data_size * 4, 0);
+	for (size_t i = 0; i < data.size(); i++)
+		data[i] = static_cast<char>(i * 7 + (i >> 12));
+	std::ofstream(filename, std::ios_base::out | std::ios_base::binary).write(data.data(), data.size());
+	std::vector<char> buffer(1024 * 1024);
+	std::string sink;
+
+	double mem = throughput(data.size(), [&] { H h(hasher); sink += result(h.absorb(data)); });
+	double file = throughput(data.size(), [&] {
+		std::ifstream f(filename, std::ios_base::in | std::ios_base::binary);
+		H h(hasher);
+		sink += result(h.absorb(f));
+	});
+	double file_buffer = throughput(data.size(), [&] {
+		std::ifstream f(filename, std::ios_base::in | std::ios_base::binary);
+		H h(hasher);
+		sink += result(h.absorb(f, buffer.data(), buffer.size()));
+	});
+	double mapped = throughput(data.size(), [&] { H h(hasher); sink += result(h.absorb_file(filename)); });
+	double str = throughput(data.size(), [&] {
+		std::istringstream s(data);
+		H h(hasher);
+		sink += result(h.absorb(s));
+	});
+	std::remove(filename);
+
+	std::cout << std::left << std::setw(16) << name << std::right << std::fixed << std::setprecision(1)
+		<< std::setw(10) << mem << std::setw(10) << file << std::setw(12) << file_buffer
+		<< std::setw(12) << mapped << std::setw(14) << str << std::endl;
+}
+
+void bench_streams()
+{
+	std::cout << "Stream absorb throughput, MB/s" << std::endl;
+	std::cout << std::left << std::setw(16) << "algorithm" << std::right << std::setw(10) << "memory"
+		<< std::setw(10) << "ifstream" << std::setw(12) << "+1M buffer" << std::setw(12) << "absorb_file"
+		<< std::setw(14) << "stringstream" << std::endl;
+
+	bench_stream("md5", digestpp::md5());
+	bench_stream("k12", digestpp::k12());
+	bench_stream("sha256", digestpp::sha256());
+}
+
+// Compare hashing many messages of the same size one by one with the batch function
+template<typename H, typename F>
+void bench_batch(const char* name, const H& hasher, F batch, size_t digest_size)
+{
+	std::cout << std::left << std::setw(16) << name << std::right << std::fixed << std::setprecision(1);
+	for (size_t size : { 64, 256, 1024, 4096 })
+	{
+		size_t count = data_size / size;
+		std::vector<unsigned char> v(data_size);
+		std::iota(v.begin(), v.end(), 0);
+		std::vector<const unsigned char*> data(count);
+		std::vector<size_t> len(count, size);
+		for (size_t i = 0; i < count; i++)
+			data[i] = v.data() + i * size;
+		std::vector<unsigned char> out(count * digest_size);
+
+		double single = throughput(v.size(), [&] {
+			for (size_t i = 0; i < count; i++)
+			{
+				H h(hasher);
+				h.absorb(data[i], size);
+				output(h, out.data() + i * digest_size, digest_size);
+			}
+		});
+		double batched = throughput(v.size(), [&] { batch(data.data(), len.data(), count, out.data()); });
+		std::cout << std::setw(10) << single << std::setw(10) << batched;
+	}
+	std::cout << std::endl;
+}
+
+void bench_batches()
+{
+	std::cout << "Batch throughput for 64, 256, 1024 and 4096-byte messages, MB/s" << std::endl;
+	std::cout << std::left << std::setw(16) << "algorithm" << std::right;
+	for (int i = 0; i < 4; i++)
+		std::cout << std::setw(10) << "single" << std::setw(10) << "batch";
+	std::cout << std::endl;
+
+	bench_batch("md5", digestpp::md5(), digestpp::md5_batch, 16);
+	bench_batch("sha1", digestpp::sha1(), digestpp::sha1_batch, 20);
+	bench_batch("sha256", digestpp::sha256(), digestpp::sha256_batch, 32);
+	bench_batch("sm3", digestpp::sm3(), digestpp::sm3_batch, 32);
+	bench_batch("sha3/256", digestpp::sha3(256), [](const unsigned char* const* data, const size_t* len, size_t count,
+		unsigned char* out) { digestpp::sha3_batch(data, len, count, out, 256); }, 32);
+	bench_batch("shake128", digestpp::shake128(), [](const unsigned char* const* data, const size_t* len, size_t count,
+		unsigned char* out) { digestpp::shake128_batch(data, len, count, out, 32); }, 32);
+}
+
+// Compare the SIMD kernels with the portable code, also as the time of one step of the compression function
+// (LSH steps, SHA-2 rounds), so that the designs can be compared on the same machine
+template<typename H>
+void bench_kernel(const char* name, const H& hasher, size_t block_size, size_t steps)
+{
+	std::vector<unsigned char> v(data_size);
+	std::iota(v.begin(), v.end(), 0);
+	std::string sink;
+
+	digestpp::detail::cpu_features& cpu = digestpp::detail::cpu_features::get();
+	digestpp::detail::cpu_features saved = cpu;
+	double simd = throughput(v.size(), [&] { H h(hasher); sink += result(h.absorb(v.data(), v.size())); });
+	cpu.disable_all();
+	double portable = throughput(v.size(), [&] { H h(hasher); sink += result(h.absorb(v.data(), v.size())); });
+	cpu = saved;
+
+	std::cout << std::left << std::setw(16) << name << std::right << std::fixed << std::setprecision(1)
+		<< std::setw(10) << simd << std::setw(10) << portable << std::setprecision(2)
+		<< std::setw(12) << block_size * 1e3 / simd / steps << std::setw(12) << block_size * 1e3 / portable / steps << std::endl;
+}
+
+void bench_kernels()
+{
+	std::cout << "Compression throughput, MB/s, and time per step, ns" << std::endl;
+	std::cout << std::left << std::setw(16) << "algorithm" << std::right << std::setw(10) << "simd"
+		<< std::setw(10) << "portable" << std::setw(12) << "simd/step" << std::setw(12) << "port./step" << std::endl;
+
+	bench_kernel("lsh256/256", digestpp::lsh256(256), 128, 26);
+	bench_kernel("sha1", digestpp::sha1(), 64, 80);
+	bench_kernel("sha256", digestpp::sha256(), 64, 64);
+	bench_kernel("lsh512/512", digestpp::lsh512(512), 256, 28);
+	bench_kernel("sha512", digestpp::sha512(), 128, 80);
+}
+
+int main()
+{
+	bench_iterators();
+	std::cout << std::endl;
+	bench_streams();
+	std::cout << std::endl;
+	bench_batches();
+	std::cout << std::endl;
+	bench_kernels();
+}
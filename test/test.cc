@@ -3,6 +3,11 @@
 #include <iostream>
 #include <numeric>
 #include <sstream>
+#include <cstdio>
+#include <deque>
+#include <fstream>
+#include <list>
+#include <thread>
 
 bool compare(const std::string& name, const std::string& actual, const std::string& expected)
 {
@@ -72,6 +77,30 @@ bool update_test(const std::string& name, const H& h)
 	return true;
 }
 
+template<typename H>
+bool iterator_test(const std::string& name, const H& h)
+{
+	std::vector<unsigned char> v(3000);
+	std::iota(v.begin(), v.end(), 0);
+	std::deque<unsigned char> d(v.begin(), v.end());
+	std::list<char> l(v.begin(), v.end());
+	std::vector<int> vi(v.begin(), v.end());
+
+	H h1 = h, h2 = h, h3 = h, h4 = h, h5 = h;
+	std::string expected = get_digest(32, h1.absorb(v.data(), v.size()));
+	std::string s2 = get_digest(32, h2.absorb(v.begin(), v.end()));
+	std::string s3 = get_digest(32, h3.absorb(d.begin(), d.end()));
+	std::string s4 = get_digest(32, h4.absorb(l.begin(), l.end()));
+	std::string s5 = get_digest(32, h5.absorb(vi.cbegin(), vi.cend()));
+
+	if (s2 != expected || s3 != expected || s4 != expected || s5 != expected)
+	{
+		std::cerr << name << " error: iterator absorb result is not equal to pointer absorb" << std::endl;
+		return false;
+	}
+	return true;
+}
+
 template<typename XOF>
 bool xof_test(const std::string& name, const std::string& ts)
 {
@@ -117,6 +146,198 @@ bool xof_test(const std::string& name, const std::string& ts)
 	return true;
 }
 
+// Compare a batch function with hashing each message separately.
+// Message lengths vary, so that lanes finish at different times and are refilled.
+template<typename F, typename H>
+bool batch_test(const std::string& name, F batch, const H& h, size_t digest_size)
+{
+	std::vector<unsigned char> v(1000);
+	std::iota(v.begin(), v.end(), 0);
+	std::vector<const unsigned char*> data;
+	std::vector<size_t> len;
+	for (size_t i = 0; i < 300; i++)
+	{
+		data.push_back(v.data() + i % 7);
+		len.push_back(i * 37 % 601);
+	}
+	std::vector<unsigned char> out(data.size() * digest_size);
+	batch(data.data(), len.data(), data.size(), out.data());
+
+	for (size_t i = 0; i < data.size(); i++)
+	{
+		H h1 = h;
+		std::string expected = get_digest(digest_size, h1.absorb(data[i], len[i]));
+		std::string actual(digest_size * 2, '0');
+		digestpp::detail::hex_encode(out.data() + i * digest_size, digest_size, &actual[0]);
+		if (!compare(name + " batch", actual, expected))
+			return false;
+	}
+	return true;
+}
+
+// Leaves hashed by several threads and SIMD lanes must give the same result as the portable code
+template<typename H>
+bool tree_test(const std::string& name, H hasher)
+{
+	std::vector<unsigned char> v(8192 * 37 + 100);
+	for (size_t i = 0; i < v.size(); i++)
+		v[i] = static_cast<unsigned char>(i * 7 + (i >> 12));
+
+	H threaded = hasher;
+	threaded.set_threads(4, 0);
+	std::string actual = threaded.absorb(v.data(), v.size()).hexsqueeze(64);
+	H split = hasher;
+	split.set_threads(3, 8192 * 5);
+	split.absorb(v.data(), 8192 * 11 + 7).absorb(v.data() + 8192 * 11 + 7, v.size() - 8192 * 11 - 7);
+	std::string actual_split = split.hexsqueeze(64);
+
+	digestpp::detail::cpu_features saved = digestpp::detail::cpu_features::get();
+	digestpp::detail::cpu_features::get().disable_all();
+	std::string expected = hasher.absorb(v.data(), v.size()).hexsqueeze(64);
+	digestpp::detail::cpu_features::get() = saved;
+	return compare(name + " threads", actual, expected) && compare(name + " threads", actual_split, expected);
+}
+
+// Output computed at any offset, by several threads and SIMD lanes must match sequential output of the portable code
+template<typename H>
+bool random_access_test(const std::string& name, H hasher, size_t size)
+{
+	hasher.absorb("The quick brown fox jumps over the lazy dog");
+	digestpp::detail::cpu_features saved = digestpp::detail::cpu_features::get();
+	digestpp::detail::cpu_features::get().disable_all();
+	H portable = hasher;
+	std::string expected = get_digest(size, portable);
+	digestpp::detail::cpu_features::get() = saved;
+
+	H threaded = hasher;
+	threaded.set_threads(3, 0);
+	if (!compare(name + " threads", get_digest(size, threaded), expected))
+		return false;
+
+	const size_t ranges[][2] = { { 0, size }, { 1, size - 1 }, { 33, 100 }, { size / 3, size / 2 }, { size - 5, 5 }, { size, 0 } };
+	for (const auto& range : ranges)
+	{
+		std::vector<unsigned char> out(range[1]);
+		threaded.squeeze_at(range[0], out.data(), out.size());
+		std::string actual(out.size() * 2, '0');
+		digestpp::detail::hex_encode(out.data(), out.size(), &actual[0]);
+		if (!compare(name + " squeeze_at", actual, expected.substr(range[0] * 2, range[1] * 2)))
+			return false;
+	}
+	return true;
+}
+
+bool hex_test()
+{
+	std::string ts = "The quick brown fox jumps over the lazy dog";
+	std::string expected = "d7a8fbb307d7809469ca9abcb0082e4f8d5651e46d3cdb762d02d0bf37c9e592";
+	std::string upper = "D7A8FBB307D7809469CA9ABCB0082E4F8D5651E46D3CDB762D02D0BF37C9E592";
+	digestpp::sha256 hasher;
+	hasher.absorb(ts);
+
+	char buf[65] = {};
+	hasher.hexdigest_to(buf);
+	bool ok = compare("SHA-256 hexdigest_to", buf, expected);
+	if (!hasher.verify_hex(expected) || !hasher.verify_hex(upper.c_str()) || hasher.verify_hex(expected.substr(2))
+		|| hasher.verify_hex("x" + expected.substr(1)) || hasher.verify_hex(expected.substr(0, 63) + "3"))
+	{
+		std::cerr << "SHA-256 verify_hex error" << std::endl;
+		ok = false;
+	}
+
+	// SIMD and portable hex encoders must agree
+	std::string simd = digestpp::shake256().absorb(ts).hexsqueeze(1000);
+	digestpp::detail::cpu_features saved = digestpp::detail::cpu_features::get();
+	digestpp::detail::cpu_features::get().disable_all();
+	ok &= compare("SHAKE256 hexsqueeze", simd, digestpp::shake256().absorb(ts).hexsqueeze(1000));
+	digestpp::detail::cpu_features::get() = saved;
+	return ok;
+}
+
+bool file_test()
+{
+	const char* filename = "digestpp_file_test.tmp";
+	std::string data(3 * 1024 * 1024 + 17, 0);
+	for (size_t i = 0; i < data.size(); i++)
+		data[i] = static_cast<char>(i * 7 + (i >> 12));
+	std::ofstream(filename, std::ios_base::out | std::ios_base::binary).write(data.data(), data.size());
+
+	std::string expected = digestpp::sha256().absorb(data).hexdigest();
+	std::string actual = digestpp::sha256().absorb_file(filename).hexdigest();
+	bool ok = compare("SHA-256 absorb_file", actual, expected);
+
+	std::ifstream file(filename, std::ios_base::in | std::ios_base::binary);
+	ok &= compare("SHA-256 absorb ifstream", digestpp::sha256().absorb(file).hexdigest(), expected);
+	std::ifstream file2(filename, std::ios_base::in | std::ios_base::binary);
+	char buffer[1000];
+	ok &= compare("SHA-256 absorb ifstream with buffer",
+		digestpp::sha256().absorb(file2, buffer, sizeof(buffer)).hexdigest(), expected);
+	std::istringstream sstream(data);
+	sstream.get();
+	ok &= compare("SHA-256 absorb stringstream", digestpp::sha256().absorb(sstream).hexdigest(),
+		digestpp::sha256().absorb(data.substr(1)).hexdigest());
+
+#ifdef DIGESTPP_POSIX_FILES
+	// Regular file from the middle of a page to the end; the position must be moved to the end of file
+	int fd = open(filename, O_RDONLY);
+	const off_t offset = 12345;
+	lseek(fd, offset, SEEK_SET);
+	ok &= compare("SHA-256 absorb_fd at offset", digestpp::sha256().absorb_fd(fd).hexdigest(),
+		digestpp::sha256().absorb(data.substr(offset)).hexdigest());
+	ok &= compare("SHA-256 absorb_fd position", std::to_string(lseek(fd, 0, SEEK_CUR)), std::to_string(data.size()));
+	close(fd);
+
+	// Pipes can't be mapped and are read until the writer closes its end
+	int pipe_fd[2];
+	if (pipe(pipe_fd) == 0)
+	{
+		std::thread writer([&data, &pipe_fd]() {
+			for (size_t pos = 0; pos < data.size(); )
+			{
+				ssize_t res = write(pipe_fd[1], data.data() + pos, std::min<size_t>(data.size() - pos, 100000));
+				if (res <= 0)
+					break;
+				pos += static_cast<size_t>(res);
+			}
+			close(pipe_fd[1]);
+		});
+		std::string actual_pipe = digestpp::sha256().absorb_fd(pipe_fd[0]).hexdigest();
+		writer.join();
+		close(pipe_fd[0]);
+		ok &= compare("SHA-256 absorb_fd pipe", actual_pipe, expected);
+	}
+	std::remove(filename);
+
+	// Sparse file spanning two map windows, so that pages behind the cursor are released and the file is mapped again.
+	// The marks check the data around the window boundary and at the end of file.
+	std::string big(64 * 1024 * 1024 + 4 * 1024 * 1024 + 100, 0);
+	const size_t marks[] = { 64 * 1024 * 1024 - 1, 64 * 1024 * 1024, big.size() - 1 };
+	fd = open(filename, O_RDWR | O_CREAT | O_TRUNC, 0600);
+	bool created = fd >= 0 && ftruncate(fd, static_cast<off_t>(big.size())) == 0;
+	for (size_t mark : marks)
+	{
+		big[mark] = static_cast<char>(mark);
+		created = created && pwrite(fd, &big[mark], 1, static_cast<off_t>(mark)) == 1;
+	}
+	if (fd >= 0)
+		close(fd);
+	if (created)
+	{
+		ok &= compare("SHA-256 absorb_file two windows", digestpp::sha256().absorb_file(filename).hexdigest(),
+			digestpp::sha256().absorb(big).hexdigest());
+		fd = open(filename, O_RDONLY);
+		lseek(fd, static_cast<off_t>(big.size() / 2), SEEK_SET);
+		ok &= compare("SHA-256 absorb_fd two windows at offset", digestpp::sha256().absorb_fd(fd).hexdigest(),
+			digestpp::sha256().absorb(big.data() + big.size() / 2, big.size() - big.size() / 2).hexdigest());
+		close(fd);
+	}
+	else
+		ok &= compare("SHA-256 sparse file", "not created", "created");
+#endif
+	std::remove(filename);
+	return ok;
+}
+
 void test_examples()
 {
 	int errors = 0;
@@ -215,6 +436,40 @@ void basic_self_test()
 	errors += !update_test("ESCH256_XOF", digestpp::esch256_xof());
 	errors += !update_test("ESCH384_XOF", digestpp::esch256_xof());
 
+	errors += !hex_test();
+	errors += !file_test();
+	errors += !iterator_test("SHA256", digestpp::sha256());
+	errors += !iterator_test("SHA-3/256", digestpp::sha3(256));
+	errors += !iterator_test("BLAKE2BP/512", digestpp::blake2bp(512));
+	errors += !iterator_test("K12", digestpp::k12());
+	errors += !tree_test("K12", digestpp::k12());
+	errors += !tree_test("KT256", digestpp::kt256());
+	errors += !tree_test("M14", digestpp::m14());
+	errors += !tree_test("Skein256 tree", digestpp::skein256_xof().set_tree(5, 1, 3));
+	errors += !tree_test("Skein512 tree", digestpp::skein512_xof().set_tree(4, 2, 255));
+	errors += !tree_test("Skein1024 tree", digestpp::skein1024_xof().set_tree(3, 1, 2));
+	errors += !tree_test("Skein256 tree, several batches", digestpp::skein256_xof().set_tree(1, 1, 255));
+	errors += !random_access_test("BLAKE2XB", digestpp::blake2xb(16000), 2000);
+	errors += !random_access_test("BLAKE2XS", digestpp::blake2xs(4000), 500);
+	errors += !random_access_test("BLAKE2XB-XOF", digestpp::blake2xb_xof().set_key("key"), 5000);
+	errors += !random_access_test("BLAKE2XS-XOF", digestpp::blake2xs_xof(), 5000);
+	errors += !batch_test("MD5", digestpp::md5_batch, digestpp::md5(), 16);
+	errors += !batch_test("SHA1", digestpp::sha1_batch, digestpp::sha1(), 20);
+	errors += !batch_test("SHA256", digestpp::sha256_batch, digestpp::sha256(), 32);
+	errors += !batch_test("SM3", digestpp::sm3_batch, digestpp::sm3(), 32);
+	for (size_t hs : { 224, 256, 384, 512 })
+	{
+		errors += !batch_test("SHA-3/" + std::to_string(hs), [hs](const unsigned char* const* data, const size_t* len,
+			size_t count, unsigned char* out) { digestpp::sha3_batch(data, len, count, out, hs); }, digestpp::sha3(hs), hs / 8);
+	}
+	for (size_t out_len : { 0, 1, 136, 168, 500 })
+	{
+		errors += !batch_test("SHAKE128", [out_len](const unsigned char* const* data, const size_t* len,
+			size_t count, unsigned char* out) { digestpp::shake128_batch(data, len, count, out, out_len); }, digestpp::shake128(), out_len);
+		errors += !batch_test("SHAKE256", [out_len](const unsigned char* const* data, const size_t* len,
+			size_t count, unsigned char* out) { digestpp::shake256_batch(data, len, count, out, out_len); }, digestpp::shake256(), out_len);
+	}
+
 	std::string ts = "The quick brown fox jumps over the lazy dog";
 
 	errors += !xof_test<digestpp::shake128>("SHAKE128", ts);
@@ -278,6 +533,22 @@ void basic_self_test()
 	errors += !compare("SHA-256", digestpp::sha256().absorb(ts).hexdigest(),
 		"d7a8fbb307d7809469ca9abcb0082e4f8d5651e46d3cdb762d02d0bf37c9e592");
 
+	errors += !compare("SHA-256", digestpp::sha256().absorb(ts).digest().hex(),
+		"d7a8fbb307d7809469ca9abcb0082e4f8d5651e46d3cdb762d02d0bf37c9e592");
+
+	errors += !compare("SHA-512/256", digestpp::sha512(256).absorb(ts).digest().hex(),
+		"dd9d67b371519c339ed8dbd25af90e976a1eeefd4ad3d889005e532fc5bef04d");
+
+	errors += !compare("SHA-512/256", digestpp::static_size::sha512<256>().absorb(ts).digest().hex(),
+		"dd9d67b371519c339ed8dbd25af90e976a1eeefd4ad3d889005e532fc5bef04d");
+
+	if (digestpp::sha256().absorb(ts).digest() != digestpp::sha256().absorb(ts).digest()
+		|| digestpp::blake2b(256).absorb(ts).digest() == digestpp::blake2b(512).absorb(ts).digest())
+	{
+		std::cerr << "digest() comparison error" << std::endl;
+		errors++;
+	}
+
 	errors += !compare("SHA-512/256", digestpp::sha512(256).absorb(ts).hexdigest(),
 		"dd9d67b371519c339ed8dbd25af90e976a1eeefd4ad3d889005e532fc5bef04d");
 
@@ -3,6 +3,18 @@
 
 int main()
 {
+	auto sha3_batch = [](size_t hs) {
+		return [hs](const unsigned char* const* data, const size_t* len, size_t count, unsigned char* out) {
+			digestpp::sha3_batch(data, len, count, out, hs);
+		};
+	};
+	auto shake128_batch = [](const unsigned char* const* data, const size_t* len, size_t count, unsigned char* out) {
+		digestpp::shake128_batch(data, len, count, out, 140);
+	};
+	auto shake256_batch = [](const unsigned char* const* data, const size_t* len, size_t count, unsigned char* out) {
+		digestpp::shake256_batch(data, len, count, out, 512);
+	};
+
 	test_vectors(digestpp::ascon_hash(), "ascon_hash", "testvectors/ascon_hash256.txt");
 	test_vectors(digestpp::blake(224), "blake/224", "testvectors/blake224.txt");
 	test_vectors(digestpp::blake(256), "blake/256", "testvectors/blake256.txt");
@@ -53,9 +65,12 @@ int main()
 	test_vectors(digestpp::lsh512(384), "lsh512/384", "testvectors/lsh512_384.txt");
 	test_vectors(digestpp::lsh512(512), "lsh512/512", "testvectors/lsh512_512.txt");
 	test_vectors(digestpp::md5(), "md5", "testvectors/md5.txt");
+	test_batch_vectors(digestpp::md5_batch, 16, "md5 batch", "testvectors/md5.txt");
 	test_vectors(digestpp::sha1(), "sha1", "testvectors/sha1.txt");
+	test_batch_vectors(digestpp::sha1_batch, 20, "sha1 batch", "testvectors/sha1.txt");
 	test_vectors(digestpp::sha224(), "sha224", "testvectors/sha224.txt");
 	test_vectors(digestpp::sha256(), "sha256", "testvectors/sha256.txt");
+	test_batch_vectors(digestpp::sha256_batch, 32, "sha256 batch", "testvectors/sha256.txt");
 	test_vectors(digestpp::sha384(), "sha384", "testvectors/sha384.txt");
 	test_vectors(digestpp::sha512(), "sha512", "testvectors/sha512.txt");
 	test_vectors(digestpp::sha512(224), "sha512/224", "testvectors/sha512_224.txt");
@@ -64,6 +79,10 @@ int main()
 	test_vectors(digestpp::sha3(256), "sha3/256", "testvectors/sha3_256.txt");
 	test_vectors(digestpp::sha3(384), "sha3/384", "testvectors/sha3_384.txt");
 	test_vectors(digestpp::sha3(512), "sha3/512", "testvectors/sha3_512.txt");
+	test_batch_vectors(sha3_batch(224), 28, "sha3/224 batch", "testvectors/sha3_224.txt");
+	test_batch_vectors(sha3_batch(256), 32, "sha3/256 batch", "testvectors/sha3_256.txt");
+	test_batch_vectors(sha3_batch(384), 48, "sha3/384 batch", "testvectors/sha3_384.txt");
+	test_batch_vectors(sha3_batch(512), 64, "sha3/512 batch", "testvectors/sha3_512.txt");
 	test_vectors(digestpp::skein256(128), "skein256/128", "testvectors/skein256_128.txt");
 	test_vectors(digestpp::skein256(160), "skein256/160", "testvectors/skein256_160.txt");
 	test_vectors(digestpp::skein256(224), "skein256/224", "testvectors/skein256_224.txt");
@@ -81,7 +100,13 @@ int main()
 	test_vectors(digestpp::skein1024(512), "skein1024/512", "testvectors/skein1024_512.txt");
 	test_vectors(digestpp::skein1024(1024), "skein1024/1024", "testvectors/skein1024_1024.txt");
 	test_vectors(digestpp::skein1024(2056), "skein1024/2056", "testvectors/skein1024_2056.txt");
+	test_vectors(digestpp::skein256(256).set_tree(1, 1, 3), "skein256/256 tree", "testvectors/skein256_tree.txt");
+	test_vectors(digestpp::skein512(512).set_tree(2, 2, 255), "skein512/512 tree", "testvectors/skein512_tree.txt");
+	test_vectors(digestpp::skein1024(1024).set_tree(1, 1, 2), "skein1024/1024 tree", "testvectors/skein1024_tree.txt");
+	test_vectors(digestpp::skein512(512).set_tree(1, 2, 3), "skein512/512 tree 2", "testvectors/skein512_tree2.txt");
+	test_vectors(digestpp::skein512(512).set_tree(1, 2, 3).set_threads(4, 0), "skein512/512 tree 2 threads", "testvectors/skein512_tree2.txt");
 	test_vectors(digestpp::sm3(), "sm3", "testvectors/sm3.txt");
+	test_batch_vectors(digestpp::sm3_batch, 32, "sm3 batch", "testvectors/sm3.txt");
 	test_vectors(digestpp::streebog(256), "streebog/256", "testvectors/streebog256.txt");
 	test_vectors(digestpp::streebog(512), "streebog/512", "testvectors/streebog512.txt");
 	test_vectors(digestpp::whirlpool(), "whirlpool", "testvectors/whirlpool.txt");
@@ -93,6 +118,8 @@ int main()
 	test_vectors(digestpp::blake2xs_xof(), "blake2xs_xof", "testvectors/blake2xs_xof.txt");
 	test_vectors(digestpp::shake128(), "shake128", "testvectors/shake128.txt");
 	test_vectors(digestpp::shake256(), "shake256", "testvectors/shake256.txt");
+	test_batch_vectors(shake128_batch, 140, "shake128 batch", "testvectors/shake128.txt");
+	test_batch_vectors(shake256_batch, 512, "shake256 batch", "testvectors/shake256.txt");
 	test_vectors(digestpp::cshake256(), "cshake256", "testvectors/cshake256.txt");
 	test_vectors(digestpp::k12(), "k12", "testvectors/k12.txt");
 	test_vectors(digestpp::kt256(), "kt256", "testvectors/kt256.txt");
@@ -101,5 +128,77 @@ int main()
 	test_vectors(digestpp::skein256_xof(), "skein256-XOF", "testvectors/skein256_xof.txt");
 	test_vectors(digestpp::skein512_xof(), "skein512-XOF", "testvectors/skein512_xof.txt");
 
+	// Narrower kernels
+	digestpp::detail::cpu_features& cpu = digestpp::detail::cpu_features::get();
+	cpu.avx512 = cpu.vbmi = cpu.vaes = cpu.sha = false;
+	test_batch_vectors(digestpp::md5_batch, 16, "md5 batch (AVX2)", "testvectors/md5.txt");
+	test_batch_vectors(digestpp::sha1_batch, 20, "sha1 batch (AVX2)", "testvectors/sha1.txt");
+	test_batch_vectors(digestpp::sha256_batch, 32, "sha256 batch (AVX2)", "testvectors/sha256.txt");
+	test_batch_vectors(sha3_batch(256), 32, "sha3/256 batch (AVX2)", "testvectors/sha3_256.txt");
+	test_batch_vectors(shake128_batch, 140, "shake128 batch (AVX2)", "testvectors/shake128.txt");
+	test_vectors(digestpp::skein1024(1024), "skein1024/1024 (AVX2)", "testvectors/skein1024_1024.txt");
+	test_vectors(digestpp::skein1024(1024).set_tree(1, 1, 2), "skein1024/1024 tree (AVX2)", "testvectors/skein1024_tree.txt");
+	test_vectors(digestpp::echo(256), "echo/256 (AES-NI)", "testvectors/echo256.txt");
+	test_vectors(digestpp::echo(512), "echo/512 (AES-NI)", "testvectors/echo512.txt");
+
+	// SSE2 kernels; AVX2 is disabled only for this block
+	digestpp::detail::cpu_features saved = cpu;
+	cpu.avx2 = false;
+	test_vectors(digestpp::jh(224), "jh/224 (SSE2)", "testvectors/jh224.txt");
+	test_vectors(digestpp::jh(256), "jh/256 (SSE2)", "testvectors/jh256.txt");
+	test_vectors(digestpp::jh(384), "jh/384 (SSE2)", "testvectors/jh384.txt");
+	test_vectors(digestpp::jh(512), "jh/512 (SSE2)", "testvectors/jh512.txt");
+	cpu = saved;
+
+	// Portable implementations of algorithms with SIMD kernels
+	cpu.disable_all();
+	test_vectors(digestpp::sha224(), "sha224 (portable)", "testvectors/sha224.txt");
+	test_vectors(digestpp::sha256(), "sha256 (portable)", "testvectors/sha256.txt");
+	test_batch_vectors(digestpp::sha256_batch, 32, "sha256 batch (portable)", "testvectors/sha256.txt");
+	test_batch_vectors(digestpp::md5_batch, 16, "md5 batch (portable)", "testvectors/md5.txt");
+	test_vectors(digestpp::sha1(), "sha1 (portable)", "testvectors/sha1.txt");
+	test_batch_vectors(digestpp::sha1_batch, 20, "sha1 batch (portable)", "testvectors/sha1.txt");
+	test_batch_vectors(sha3_batch(256), 32, "sha3/256 batch (portable)", "testvectors/sha3_256.txt");
+	test_batch_vectors(shake256_batch, 512, "shake256 batch (portable)", "testvectors/shake256.txt");
+	test_vectors(digestpp::k12(), "k12 (portable)", "testvectors/k12.txt");
+	test_vectors(digestpp::kt256(), "kt256 (portable)", "testvectors/kt256.txt");
+	test_vectors(digestpp::sha384(), "sha384 (portable)", "testvectors/sha384.txt");
+	test_vectors(digestpp::sha512(), "sha512 (portable)", "testvectors/sha512.txt");
+	test_vectors(digestpp::sha512(224), "sha512/224 (portable)", "testvectors/sha512_224.txt");
+	test_vectors(digestpp::sha512(256), "sha512/256 (portable)", "testvectors/sha512_256.txt");
+	test_vectors(digestpp::blake2sp(256), "blake2sp/256 (portable)", "testvectors/blake2sp_256.txt");
+	test_vectors(digestpp::blake2bp(512), "blake2bp/512 (portable)", "testvectors/blake2bp_512.txt");
+	test_vectors(digestpp::blake2b(256), "blake2b/256 (portable)", "testvectors/blake2b_256.txt");
+	test_vectors(digestpp::blake2b(512), "blake2b/512 (portable)", "testvectors/blake2b_512.txt");
+	test_vectors(digestpp::blake2xb(2056), "blake2xb/2056-param (portable)", "testvectors/blake2xb_2056param.txt");
+	test_vectors(digestpp::blake2xb_xof(), "blake2xb_xof (portable)", "testvectors/blake2xb_xof.txt");
+	test_vectors(digestpp::blake2s(256), "blake2s/256 (portable)", "testvectors/blake2s_256.txt");
+	test_vectors(digestpp::blake2xs(2056), "blake2xs/2056-param (portable)", "testvectors/blake2xs_2056param.txt");
+	test_vectors(digestpp::blake2xs_xof(), "blake2xs_xof (portable)", "testvectors/blake2xs_xof.txt");
+	test_vectors(digestpp::skein512(512), "skein512/512 (portable)", "testvectors/skein512_512.txt");
+	test_vectors(digestpp::skein512(2056), "skein512/2056 (portable)", "testvectors/skein512_2056.txt");
+	test_vectors(digestpp::skein512_xof(), "skein512-XOF (portable)", "testvectors/skein512_xof.txt");
+	test_vectors(digestpp::skein1024(1024), "skein1024/1024 (portable)", "testvectors/skein1024_1024.txt");
+	test_vectors(digestpp::skein1024(2056), "skein1024/2056 (portable)", "testvectors/skein1024_2056.txt");
+	test_vectors(digestpp::skein512(512).set_tree(1, 2, 3), "skein512/512 tree 2 (portable)", "testvectors/skein512_tree2.txt");
+	test_vectors(digestpp::groestl(224), "groestl/224 (portable)", "testvectors/groestl224.txt");
+	test_vectors(digestpp::groestl(256), "groestl/256 (portable)", "testvectors/groestl256.txt");
+	test_vectors(digestpp::groestl(384), "groestl/384 (portable)", "testvectors/groestl384.txt");
+	test_vectors(digestpp::groestl(512), "groestl/512 (portable)", "testvectors/groestl512.txt");
+	test_vectors(digestpp::echo(224), "echo/224 (portable)", "testvectors/echo224.txt");
+	test_vectors(digestpp::echo(384), "echo/384 (portable)", "testvectors/echo384.txt");
+	test_vectors(digestpp::echo(256), "echo/256 (portable)", "testvectors/echo256.txt");
+	test_vectors(digestpp::echo(512), "echo/512 (portable)", "testvectors/echo512.txt");
+	test_vectors(digestpp::kupyna(256), "kupyna/256 (portable)", "testvectors/kupyna256.txt");
+	test_vectors(digestpp::kupyna(512), "kupyna/512 (portable)", "testvectors/kupyna512.txt");
+	test_vectors(digestpp::streebog(256), "streebog/256 (portable)", "testvectors/streebog256.txt");
+	test_vectors(digestpp::streebog(512), "streebog/512 (portable)", "testvectors/streebog512.txt");
+	test_vectors(digestpp::jh(256), "jh/256 (portable)", "testvectors/jh256.txt");
+	test_vectors(digestpp::jh(512), "jh/512 (portable)", "testvectors/jh512.txt");
+	test_vectors(digestpp::lsh256(256), "lsh256/256 (portable)", "testvectors/lsh256_256.txt");
+	test_vectors(digestpp::lsh512(512), "lsh512/512 (portable)", "testvectors/lsh512_512.txt");
+	test_vectors(digestpp::sm3(), "sm3 (portable)", "testvectors/sm3.txt");
+	test_batch_vectors(digestpp::sm3_batch, 32, "sm3 batch (portable)", "testvectors/sm3.txt");
+
 }
 
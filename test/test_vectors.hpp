@@ -2,6 +2,7 @@
 #include <regex>
 #include <iostream>
 #include <fstream>
+#include <vector>
 #include <digestpp/digestpp.hpp>
 
 template<typename T>
@@ -128,6 +129,20 @@ void set_key(const std::string& key, H& hasher)
 	hasher.set_key(key);
 }
 
+inline void report_results(const char* name, const char* filename, unsigned int count, unsigned int failed, unsigned int success)
+{
+	std::cout << name << ": ";
+	if (success)
+		std::cout << success << "/" << count << " OK";
+	if (failed && success)
+		std::cout << ", ";
+	if (failed)
+		std::cout << failed << "/" << count << " FAILED";
+	if (!success && !failed)
+		std::cout << "No tests found. Make sure that file " << filename << " exists.";
+	std::cout << std::endl;
+}
+
 template<typename H>
 void test_vectors(const H& hasher, const char* name, const char* filename)
 {
@@ -184,15 +199,53 @@ void test_vectors(const H& hasher, const char* name, const char* filename)
 			copy.reset();
 		}
 	}
-	std::cout << name << ": ";
-	if (success)
-		std::cout << success << "/" << count << " OK";
-	if (failed && success)
-		std::cout << ", ";
-	if (failed)
-		std::cout << failed << "/" << count << " FAILED";
-	if (!success && !failed)
-		std::cout << "No tests found. Make sure that file " << filename << " exists.";
-	std::cout << std::endl;
+	report_results(name, filename, count, failed, success);
+}
+
+// Hash all messages from the file with one call to a batch function,
+// which has the signature batch(data, len, count, out) and writes digest_size bytes per message.
+template<typename F>
+void test_batch_vectors(F batch, size_t digest_size, const char* name, const char* filename)
+{
+	std::ifstream file(filename, std::ios::in);
+	std::string line;
+	std::vector<std::string> messages, expected;
+	while (std::getline(file, line))
+	{
+		auto splitted = split_vector(line);
+		if (splitted.first == "Msg")
+			messages.push_back(hex2string(splitted.second));
+		if (splitted.first == "MD")
+		{
+			std::transform(splitted.second.begin(), splitted.second.end(), splitted.second.begin(), [](unsigned char c) { return tolower(c); });
+			expected.push_back(splitted.second);
+		}
+	}
+
+	std::vector<const unsigned char*> data;
+	std::vector<size_t> len;
+	for (const auto& msg : messages)
+	{
+		data.push_back(reinterpret_cast<const unsigned char*>(msg.data()));
+		len.push_back(msg.size());
+	}
+	std::vector<unsigned char> out(messages.size() * digest_size);
+	batch(data.data(), len.data(), messages.size(), out.data());
+
+	unsigned int count = 0, failed = 0, success = 0;
+	for (size_t i = 0; i < expected.size() && i < messages.size(); i++)
+	{
+		std::string actual(digest_size * 2, '0');
+		digestpp::detail::hex_encode(out.data() + i * digest_size, digest_size, &actual[0]);
+		if (expected[i] != actual)
+		{
+			std::cerr << "\nError for test " << count << "\nExpected: " << expected[i]
+				<< "\nActual: " << actual << std::endl;
+			failed++;
+		}
+		else success++;
+		count++;
+	}
+	report_results(name, filename, count, failed, success);
 }
 